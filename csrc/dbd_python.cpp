@@ -10,18 +10,40 @@
 #include "SensorsMap.H"
 #include "KnownBytes.H"
 #include "Decompress.H"
+#include "DecodePlan.H"
+#include "ByteSource.H"
 #include "ColumnData.H"
+#include "ColumnArena.H"
+#include "ColumnCache.H"
+#include "Executor.H"
 #include "MyException.H"
+#ifdef HAVE_NETCDF
+#include "NetCDFWriter.H"
+#endif
+#include "Parallel.H"
+#include "RecordIndex.H"
+#include "SensorCache.H"
+#include "ReadStats.H"
+#include "TimeSync.H"
 
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
-#include <unordered_map>
 
 namespace py = pybind11;
 namespace fs = std::filesystem;
@@ -41,19 +63,24 @@ struct HeaderFields {
 };
 
 struct SingleFileResult {
-    std::vector<TypedColumn> columns;
+    std::unique_ptr<ColumnArena> columns; // n_records rows of each sensor
     std::vector<SensorInfo> sensor_info;
     size_t n_records = 0;
-    size_t start = 0;  // 0 or 1, for skip_first_record slicing
     HeaderFields header;
     std::string filename;
+    bool qSparse = false;
+    std::vector<SparseColumn> sparse{}; // Instead of columns, if qSparse
+    ColumnCache::tPtr cached{}; // If set, holds the named columns from row
+    size_t cachedStart = 0;     // cachedStart, and columns the unnamed ones
 };
 
 struct MultiFileResult {
-    std::vector<TypedColumn> columns;
+    std::unique_ptr<ColumnArena> columns;
     std::vector<SensorInfo> sensor_info;
     size_t n_records = 0;
     size_t n_files = 0;
+    bool qSparse = false;
+    std::vector<SparseColumn> sparse{}; // Instead of columns, if qSparse
 };
 
 struct SensorListResult {
@@ -76,27 +103,568 @@ struct HeaderScanResult {
 
 // ── Pure-C++ parsing (called with GIL released) ────────────────────────
 
+// A decompression buffer taken from a process-wide pool, so consecutive
+// files reuse the same memory. The pool is shared because a pipelined
+// read fills a buffer on its loader thread and frees it on a decoder
+// thread. Buffers that grew unusually large are released, as are any
+// beyond the few a read keeps in flight.
+class ScratchBuffer {
+    static constexpr size_t MAX_POOLED = size_t{64} * 1024 * 1024;
+    static constexpr size_t MAX_BUFFERS = 32;
+    struct Pool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<std::vector<char>>> buffers;
+    };
+    static Pool& pool() {
+        static Pool p;
+        return p;
+    }
+    std::unique_ptr<std::vector<char>> mBuf;
+public:
+    ScratchBuffer() {
+        Pool& p = pool();
+        {
+            std::lock_guard<std::mutex> lock(p.mutex);
+            if (!p.buffers.empty()) {
+                mBuf = std::move(p.buffers.back());
+                p.buffers.pop_back();
+            }
+        }
+        if (!mBuf) mBuf = std::make_unique<std::vector<char>>();
+    }
+    ~ScratchBuffer() {
+        if (mBuf->capacity() > MAX_POOLED) return;
+        Pool& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.buffers.size() < MAX_BUFFERS) p.buffers.push_back(std::move(mBuf));
+    }
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    std::vector<char>& get() { return *mBuf; }
+};
+
+// An opened DBD file, held contiguously in memory and parsed in place
+// through a SpanStream: uncompressed files are memory-mapped, compressed
+// ones are mapped and all their LZ4 blocks decoded into a pooled scratch
+// buffer. qHeaderOnly streams compressed files through DecompressTWR
+// instead, for callers that stop after the header and sensor list.
+// A file that cannot be opened yields a stream in the failed state.
+class DBDInput {
+    std::unique_ptr<ByteSource> mBytes;
+    std::unique_ptr<ScratchBuffer> mScratch;
+    const char* mData = nullptr;
+    size_t mSize = 0;
+    std::unique_ptr<std::istream> mIS;
+public:
+    explicit DBDInput(const std::string& fn, bool qHeaderOnly = false) {
+        const bool qLZ4 = qCompressed(fn);
+        if (qLZ4 && qHeaderOnly) {
+            mIS = std::make_unique<DecompressTWR>(fn, true);
+            return;
+        }
+        mBytes = std::make_unique<ByteSource>(fn);
+        ReadStats::add(ReadStats::BYTES_READ, mBytes->size());
+        if (qLZ4) {
+            mScratch = std::make_unique<ScratchBuffer>();
+            mSize = decompressTWR(mBytes->data(), mBytes->size(), mScratch->get());
+            mData = mScratch->get().data();
+        } else {
+            mData = mBytes->data();
+            mSize = mBytes->size();
+        }
+        mIS = std::make_unique<SpanStream>(mData, mSize);
+        if (!mBytes->isOpen()) mIS->setstate(std::ios::failbit);
+    }
+
+    std::istream& stream() { return *mIS; }
+
+    // Whether the contents are a decompressed copy rather than the mapped
+    // file, and so cost a decompression to load again
+    bool qDecompressed() const { return mScratch != nullptr; }
+    size_t size() const { return mSize; }
+
+    // Bytes from pos to the end of the file's contents. Returns false for
+    // streamed (qHeaderOnly) input or a position past the end.
+    bool span(std::streamoff pos, const char*& data, size_t& n) const {
+        if (!mBytes || !mBytes->isOpen()) return false;
+        if (pos < 0 || static_cast<size_t>(pos) > mSize) return false;
+        data = mData + pos;
+        n = mSize - static_cast<size_t>(pos);
+        return true;
+    }
+
+    // Bytes from the current stream position to the end of the contents
+    bool remaining(const char*& data, size_t& n) {
+        return span(mIS->tellg(), data, n);
+    }
+};
+
+// The start of a DBD file, for scans that stop after the header, sensor
+// list and known bytes: the first nBytes, or for a compressed file the
+// LZ4 blocks holding them, read into memory instead of mapping the file
+// or setting up a streambuf. Unless the whole file was read, the prefix
+// is cut after its last newline, so a parse that needs more fails on a
+// missing line instead of taking part of one; qShort() then tells the
+// caller to try again with a longer prefix.
+class HeadInput {
+    std::vector<char> mContents;
+    std::unique_ptr<SpanStream> mIS;
+    bool mqWhole = true;
+public:
+    HeadInput(const std::string& fn, size_t nBytes) {
+        std::ifstream is(fn, std::ios::binary);
+        const bool qOpen = is.is_open();
+        size_t n = 0;
+        if (qOpen && qCompressed(fn)) {
+            // One block at a time, each framed by its big-endian length
+            std::vector<char> raw;
+            mqWhole = false;
+            while (n < nBytes) {
+                const size_t at = raw.size();
+                raw.resize(at + 2);
+                if (!is.read(raw.data() + at, 2)) { mqWhole = true; break; }
+                const unsigned char* sz = reinterpret_cast<const unsigned char*>(raw.data() + at);
+                const size_t m = (sz[0] << 8) | sz[1];
+                raw.resize(at + 2 + m);
+                if (!is.read(raw.data() + at + 2, static_cast<std::streamsize>(m))) { mqWhole = true; break; }
+                size_t used = 0;
+                n = decompressTWR(raw.data() + at, m + 2, mContents, n, used);
+                if (used == 0) { mqWhole = true; break; } // Corrupt, so the end of the contents
+            }
+            ReadStats::add(ReadStats::BYTES_READ, raw.size());
+        } else if (qOpen) {
+            mContents.resize(nBytes);
+            is.read(mContents.data(), static_cast<std::streamsize>(nBytes));
+            n = static_cast<size_t>(is.gcount());
+            mqWhole = n < nBytes;
+            ReadStats::add(ReadStats::BYTES_READ, n);
+        }
+        if (!mqWhole) {
+            while (n > 0 && mContents[n - 1] != '\n') --n;
+        }
+        mIS = std::make_unique<SpanStream>(mContents.data(), n);
+        if (!qOpen) mIS->setstate(std::ios::failbit);
+    }
+
+    std::istream& stream() { return *mIS; }
+
+    // Whether a parse ran into the end of a prefix that is not the file
+    bool qShort() const { return !mqWhole && !mIS->good(); }
+};
+
+// parse(is) on the start of fn, from HeadInput prefixes of growing length
+// and then, for a header too long for any of them, from the whole file
+// streamed. parse must catch its own errors and leave no trace of a
+// parse that failed, so it can be run again.
+template <typename Parse>
+auto scan_head(const std::string& fn, Parse&& parse) -> decltype(parse(std::declval<std::istream&>())) {
+    constexpr size_t HEAD_BYTES = 4096;        // A factored header and the known bytes
+    constexpr size_t HEAD_LIMIT = size_t{2} << 20;
+    for (size_t n = HEAD_BYTES; n <= HEAD_LIMIT; n *= 8) {
+        HeadInput in(fn, n);
+        auto result = parse(in.stream());
+        if (!in.qShort()) return result;
+    }
+    DBDInput in(fn, true);
+    return parse(in.stream());
+}
+
+// ── Row selection ──────────────────────────────────────────────────────
+
+// A range of a time sensor to keep rows from; either end may be open.
+// Rows whose time is missing are never in a window.
+struct TimeWindow {
+    std::optional<double> start;
+    std::optional<double> end;
+    std::string sensor; // Empty for m_present_time, or sci_m_present_time without it
+
+    bool active() const { return start || end; }
+
+    // Whether times spanning [lo, hi] (NaN if none) can fall in the window
+    bool overlaps(double lo, double hi) const {
+        return !std::isnan(lo) && !std::isnan(hi)
+            && (!start || hi >= *start) && (!end || lo <= *end);
+    }
+};
+
+// Further ranges of sensor values to keep rows by, either end open
+using ValueRanges = std::map<std::string, std::pair<std::optional<double>, std::optional<double>>>;
+
+RowRange make_range(size_t column, const std::optional<double>& lo,
+                    const std::optional<double>& hi) {
+    return {column, lo.value_or(-INFINITY), hi.value_or(INFINITY)};
+}
+
+size_t column_of(const std::vector<SensorInfo>& info, const std::string& name) {
+    for (size_t i = 0; i < info.size(); ++i) {
+        if (info[i].name == name) return i;
+    }
+    throw std::invalid_argument("Sensor '" + name + "' is not in any file");
+}
+
+// The row filter for a window on timeSensor and ranges, over the output
+// columns info, which must include every sensor they name
+RowFilter make_row_filter(const std::vector<SensorInfo>& info, const TimeWindow& window,
+                          const std::string& timeSensor, const ValueRanges& ranges) {
+    RowFilter filter;
+    if (window.active()) {
+        filter.push_back(make_range(column_of(info, timeSensor), window.start, window.end));
+    }
+    for (const auto& [name, range] : ranges) {
+        filter.push_back(make_range(column_of(info, name), range.first, range.second));
+    }
+    return filter;
+}
+
+// The sensor a window applies to, given whether a sensor name is known:
+// the one named, else m_present_time, else sci_m_present_time
+template <typename Known>
+std::string resolve_time_sensor(const TimeWindow& window, Known&& qKnown) {
+    std::string name = window.sensor;
+    if (name.empty()) {
+        name = qKnown("m_present_time") ? "m_present_time" : "sci_m_present_time";
+    }
+    if (!qKnown(name)) {
+        throw std::invalid_argument("Time sensor '" + name + "' is not in any file");
+    }
+    return name;
+}
+
+// Which rows of a decoded result pass filter, for the stream kernel,
+// which decodes every row
+template <typename T>
+void mark_rows(const T* col, const RowRange& r, std::vector<uint8_t>& keep) {
+    for (size_t i = 0; i < keep.size(); ++i) {
+        const double v = (std::is_integral_v<T> && col[i] == fill_value<T>()) ? NAN : col[i];
+        keep[i] &= !std::isnan(v) && v >= r.lo && v <= r.hi;
+    }
+}
+
+std::vector<uint8_t> filter_rows(const ColumnArena& arena, const RowFilter& filter) {
+    std::vector<uint8_t> keep(arena.nRows(), 1);
+    for (const RowRange& r : filter) {
+        switch (arena.kind(r.column)) {
+            case KIND_INT8: mark_rows(arena.column<int8_t>(r.column), r, keep); break;
+            case KIND_INT16: mark_rows(arena.column<int16_t>(r.column), r, keep); break;
+            case KIND_FLOAT32: mark_rows(arena.column<float>(r.column), r, keep); break;
+            default: mark_rows(arena.column<double>(r.column), r, keep); break;
+        }
+    }
+    return keep;
+}
+
+template <typename T>
+void copy_rows(const std::vector<T>& vec, size_t start, ColumnArena& arena, size_t i) {
+    std::copy_n(vec.data() + start, arena.nRows(), arena.column<T>(i));
+}
+
+// Decode the data section that follows the known bytes into an arena of
+// the plan's output columns, dropping the first record if qSkipFirst and
+// keeping only the rows that pass filter. Memory-resident data goes
+// through the span kernel, pre-scanned so the arena is sized exactly and
+// filtered as it is decoded; anything else through the stream kernel.
+std::unique_ptr<ColumnArena> decode_columns(DBDInput& in,
+                                            const KnownBytes& kb,
+                                            const Sensors& sensors,
+                                            const DecodePlan& plan,
+                                            bool repair,
+                                            bool qSkipFirst,
+                                            const RowFilter& filter,
+                                            size_t& nRecords) {
+    const char* data = nullptr;
+    size_t n = 0;
+    if (in.remaining(data, n)) {
+        if (!filter.empty()) {
+            bool qFirst = false;
+            const size_t total = count_records(data, n, kb, plan, repair, filter, qFirst);
+            const size_t start = (qSkipFirst && qFirst) ? 1 : 0;
+            nRecords = total - start;
+            auto arena = std::make_unique<ColumnArena>(plan.sensorInfo, nRecords);
+            const std::vector<void*> ptrs = arena->pointers();
+            read_columns(data, n, kb, plan, repair, ColumnSink{ptrs.data(), 0, start, nRecords}, filter);
+            return arena;
+        }
+        const size_t total = count_records(data, n, plan, repair);
+        const size_t start = (qSkipFirst && total > 0) ? 1 : 0;
+        nRecords = total - start;
+        auto arena = std::make_unique<ColumnArena>(plan.sensorInfo, nRecords);
+        const std::vector<void*> ptrs = arena->pointers();
+        read_columns(data, n, kb, plan, repair, ColumnSink{ptrs.data(), 0, start, nRecords});
+        return arena;
+    }
+
+    ColumnDataResult result = read_columns(in.stream(), kb, sensors, repair, size_t{1024} * 1024);
+    const size_t start = (qSkipFirst && result.n_records > 0) ? 1 : 0;
+    nRecords = result.n_records - start;
+    auto arena = std::make_unique<ColumnArena>(result.sensor_info, nRecords);
+    for (size_t i = 0; i < result.columns.size(); ++i) {
+        std::visit([&](const auto& vec) { copy_rows(vec, start, *arena, i); }, result.columns[i]);
+    }
+    if (!filter.empty()) {
+        nRecords = arena->keep_rows(filter_rows(*arena, filter));
+    }
+    return arena;
+}
+
+// A sparse column of info's type with no rows, to append rows to
+SparseColumn empty_sparse(const SensorInfo& info) {
+    SparseColumn col;
+    switch (column_kind(info.size)) {
+        case KIND_INT8: col.values = std::vector<int8_t>(); break;
+        case KIND_INT16: col.values = std::vector<int16_t>(); break;
+        case KIND_FLOAT32: col.values = std::vector<float>(); break;
+        default: col.values = std::vector<double>(); break;
+    }
+    return col;
+}
+
+// Append a file's sparse column to dst, which must be of its type,
+// dropping its rows before start and moving the rest to follow row offset
+void append_sparse(SparseColumn& dst, SparseColumn&& src, size_t start, size_t offset) {
+    if (dst.rows.empty() && start == 0 && offset == 0) {
+        dst = std::move(src);
+        return;
+    }
+    const int64_t begin = static_cast<int64_t>(start);
+    const int64_t shift = static_cast<int64_t>(offset) - begin;
+    size_t from = 0;
+    while (from < src.rows.size() && src.rows[from] + src.counts[from] <= begin) ++from;
+    for (size_t j = from; j < src.rows.size(); ++j) {
+        const int64_t first = std::max(src.rows[j], begin); // Only the first run can start early
+        dst.rows.push_back(first + shift);
+        dst.counts.push_back(src.rows[j] + src.counts[j] - first);
+    }
+    std::visit([&](auto& out) {
+        const auto& in = std::get<std::decay_t<decltype(out)>>(src.values);
+        out.insert(out.end(), in.begin() + static_cast<std::ptrdiff_t>(from), in.end());
+    }, dst.values);
+}
+
+// Mark the rows of the runs of a sparse column whose value is within r
+template <typename T>
+void mark_sparse(const SparseColumn& col, const std::vector<T>& vals, const RowRange& r,
+                 std::vector<uint8_t>& ok) {
+    for (size_t j = 0; j < vals.size(); ++j) {
+        const double v = (std::is_integral_v<T> && vals[j] == fill_value<T>()) ? NAN : vals[j];
+        if (std::isnan(v) || v < r.lo || v > r.hi) continue;
+        const auto first = ok.begin() + col.rows[j];
+        std::fill(first, first + col.counts[j], 1);
+    }
+}
+
+// Keep only the rows of nRows-row sparse columns that pass filter, as
+// filter_rows does for dense ones: a row passes if each range's column has
+// a value there within it. Kept rows are renumbered in order, so the rows
+// a run keeps stay one run; returns how many rows are kept.
+size_t filter_sparse(std::vector<SparseColumn>& columns, const RowFilter& filter, size_t nRows) {
+    std::vector<uint8_t> keep(nRows, 1);
+    std::vector<uint8_t> ok;
+    for (const RowRange& r : filter) {
+        const SparseColumn& col = columns[r.column];
+        ok.assign(nRows, 0);
+        std::visit([&](const auto& vals) { mark_sparse(col, vals, r, ok); }, col.values);
+        for (size_t i = 0; i < nRows; ++i) keep[i] &= ok[i];
+    }
+
+    std::vector<int64_t> index(nRows + 1); // Kept rows before each row
+    for (size_t i = 0; i < nRows; ++i) index[i + 1] = index[i] + keep[i];
+    for (SparseColumn& col : columns) {
+        std::visit([&](auto& vals) {
+            size_t m = 0;
+            for (size_t j = 0; j < vals.size(); ++j) {
+                const size_t first = static_cast<size_t>(col.rows[j]);
+                const size_t last = first + static_cast<size_t>(col.counts[j]);
+                const int64_t n = index[last] - index[first];
+                if (n == 0) continue;
+                col.rows[m] = index[first];
+                col.counts[m] = n;
+                vals[m++] = vals[j];
+            }
+            col.rows.resize(m);
+            col.counts.resize(m);
+            vals.resize(m);
+        }, col.values);
+    }
+    return static_cast<size_t>(index[nRows]);
+}
+
 HeaderFields extract_header_fields(const Header& hdr) {
     return {
-        hdr.find("mission_name"),
-        hdr.find("fileopen_time"),
-        hdr.find("encoding_ver"),
-        hdr.find("full_filename"),
-        hdr.find("sensor_list_crc"),
-        hdr.find("the8x3_filename"),
-        hdr.find("filename_extension"),
+        std::string(hdr.missionName()),
+        std::string(hdr.fileopenTime()),
+        std::string(hdr.value("encoding_ver")),
+        std::string(hdr.value("full_filename")),
+        std::string(hdr.sensorListCRC()),
+        std::string(hdr.value("the8x3_filename")),
+        std::string(hdr.value("filename_extension")),
     };
 }
 
+// The sensor list following a file's header: inline (and then written to
+// the cache) or from the cache
+Sensors read_sensors(std::istream& is, const Header& hdr, const std::string& filename,
+                     const std::string& cache_dir) {
+    Sensors sensors(is, hdr, cache_dir);
+
+    if (sensors.empty() && !cache_dir.empty()) {
+        sensors.load(cache_dir, hdr);
+    } else if (!sensors.empty() && !cache_dir.empty()) {
+        sensors.dump(cache_dir);
+    }
+
+    if (sensors.empty()) {
+        throw std::runtime_error("No sensors found for " + filename);
+    }
+    return sensors;
+}
+
+// ── Column cache ───────────────────────────────────────────────────────
+
+// The column cache file of a data file, written from its data section
+// (read as kb says) with every sensor kept, in a column of its own, and
+// selecting records; nullptr if it cannot be cached or written, such as
+// when a sensor's values cannot be stored
+ColumnCache::tPtr write_column_cache(const std::string& cache_dir, const std::string& filename,
+                                     const Sensors& sensors, const char* data, size_t n,
+                                     const KnownBytes& kb, bool repair) {
+    Sensors all(sensors);
+    for (size_t i = 0; i < all.size(); ++i) {
+        all[i].qKeep(true);
+        all[i].qCriteria(true);
+        all[i].index(static_cast<int>(i));
+    }
+    all.nToStore(all.size());
+    const DecodePlan plan(all);
+    if (std::any_of(plan.stop.begin(), plan.stop.end(), [](uint8_t q) { return q != 0; })) {
+        return nullptr;
+    }
+
+    const size_t nRecords = count_records(data, n, plan, repair);
+    ColumnArena arena(plan.sensorInfo, nRecords);
+    const std::vector<void*> ptrs = arena.pointers();
+    read_columns(data, n, kb, plan, repair, ColumnSink{ptrs.data(), 0, 0, nRecords});
+    const std::vector<const void*> columns(ptrs.begin(), ptrs.end());
+    if (!ColumnCache::save(cache_dir, filename, sensors.crc(), repair, plan.sensorInfo,
+                           columns, nRecords)) {
+        return nullptr;
+    }
+    return ColumnCache::load(cache_dir, filename, sensors.crc(), repair);
+}
+
+// Whether a cache file holds every column plan decodes, in its type
+bool covers(const ColumnCache& cache, const DecodePlan& plan) {
+    for (size_t oi = 0; oi < plan.nOut(); ++oi) {
+        const SensorInfo& si = plan.sensorInfo[oi];
+        if (si.name.empty()) continue;
+        const ColumnCache::Column* col = cache.find(si.name);
+        if (!col || column_kind(col->info.size) != plan.colKind[oi]) return false;
+    }
+    return true;
+}
+
+// Copy the rows a sink asks for of each column plan decodes from a cache
+// file that covers it, as read_columns would decode them
+void read_cached(const ColumnCache& cache, const DecodePlan& plan, const ColumnSink& sink) {
+    if (sink.start >= cache.nRecords()) return;
+    const size_t n = std::min(sink.nRows, cache.nRecords() - sink.start);
+    for (size_t oi = 0; oi < plan.nOut(); ++oi) {
+        if (plan.sensorInfo[oi].name.empty()) continue;
+        const ColumnCache::Column* col = cache.find(plan.sensorInfo[oi].name);
+        const size_t size = ColumnArena::element_size(static_cast<ColumnKind>(plan.colKind[oi]));
+        std::memcpy(static_cast<char*>(sink.columns[oi]) + sink.offset * size,
+                    col->data + sink.start * size, n * size);
+    }
+}
+
+// A single-file read taken from the file's column cache file, written
+// first if there is none; nullopt if the file cannot be cached, to be
+// read as usual. Only the header and sensor list are parsed on a hit.
+std::optional<SingleFileResult> read_cached_file(
+    const std::string& filename,
+    const std::string& cache_dir,
+    const std::vector<std::string>& to_keep,
+    bool skip_first_record,
+    bool repair)
+{
+    using tHead = std::pair<HeaderFields, Sensors>;
+    std::optional<tHead> head = scan_head(filename, [&](std::istream& is) -> std::optional<tHead> {
+        try {
+            if (!is) return std::nullopt;
+            Header hdr(is, filename.c_str());
+            if (hdr.empty()) return std::nullopt;
+            return tHead(extract_header_fields(hdr), read_sensors(is, hdr, filename, cache_dir));
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    });
+    if (!head) return std::nullopt;
+    Sensors& sensors = head->second;
+
+    ColumnCache::tPtr cache = ColumnCache::load(cache_dir, filename, sensors.crc(), repair);
+    if (cache) {
+        ReadStats::add(ReadStats::COLUMN_CACHE_HITS, 1);
+    } else {
+        ReadStats::add(ReadStats::COLUMN_CACHE_MISSES, 1);
+        try {
+            DBDInput in(filename);
+            std::istream& is = in.stream();
+            const Header hdr(is, filename.c_str());
+            const Sensors fileSensors = read_sensors(is, hdr, filename, cache_dir);
+            const KnownBytes kb(is);
+            const char* data = nullptr;
+            size_t n = 0;
+            if (in.remaining(data, n)) {
+                cache = write_column_cache(cache_dir, filename, fileSensors, data, n, kb, repair);
+            }
+        } catch (const std::exception&) {
+            // Left to the usual read to report
+        }
+        if (!cache) return std::nullopt;
+    }
+
+    if (!to_keep.empty()) {
+        sensors.qKeep(Sensors::tNames(to_keep.begin(), to_keep.end()));
+    }
+    const DecodePlan plan(sensors);
+    if (!covers(*cache, plan)) return std::nullopt;
+
+    const size_t start = (skip_first_record && cache->nRecords() > 0) ? 1 : 0;
+    const size_t nRecords = cache->nRecords() - start;
+    std::vector<SensorInfo> gaps; // Columns between kept sensors, as decoded
+    for (const SensorInfo& si : plan.sensorInfo) {
+        if (si.name.empty()) gaps.push_back(si);
+    }
+    SingleFileResult result{std::make_unique<ColumnArena>(gaps, nRecords), plan.sensorInfo,
+                            nRecords, std::move(head->first), filename};
+    result.cached = std::move(cache);
+    result.cachedStart = start;
+    return result;
+}
+
 SingleFileResult parse_single_file(
     const std::string& filename,
     const std::string& cache_dir,
     const std::vector<std::string>& to_keep,
     const std::vector<std::string>& criteria,
     bool skip_first_record,
-    bool repair)
+    bool repair,
+    const TimeWindow& window = {},
+    const ValueRanges& ranges = {},
+    bool sparse = false,
+    bool column_cache = false)
 {
-    DecompressTWR is(filename, qCompressed(filename));
+    if (column_cache && cache_dir.empty()) {
+        throw std::invalid_argument("column_cache needs a cache_dir");
+    }
+    if (column_cache && criteria.empty() && !window.active() && ranges.empty() && !sparse) {
+        std::optional<SingleFileResult> cached =
+            read_cached_file(filename, cache_dir, to_keep, skip_first_record, repair);
+        if (cached) return std::move(*cached);
+    }
+
+    DBDInput in(filename);
+    std::istream& is = in.stream();
     if (!is) {
         throw std::runtime_error("Cannot open file: " + filename);
     }
@@ -106,20 +674,24 @@ SingleFileResult parse_single_file(
         throw std::runtime_error("Empty or invalid header in " + filename);
     }
 
-    Sensors sensors(is, hdr);
-
-    if (sensors.empty() && !cache_dir.empty()) {
-        sensors.load(cache_dir, hdr);
-    } else if (!sensors.empty() && !cache_dir.empty()) {
-        sensors.dump(cache_dir);
-    }
+    Sensors sensors = read_sensors(is, hdr, filename, cache_dir);
 
-    if (sensors.empty()) {
-        throw std::runtime_error("No sensors found for " + filename);
+    // Sensors rows are selected by are always decoded, and so output
+    const auto qKnown = [&sensors](const std::string& name) {
+        return std::any_of(sensors.begin(), sensors.end(),
+                           [&name](const Sensor& s) { return s.name() == name; });
+    };
+    const std::string timeSensor = window.active() ? resolve_time_sensor(window, qKnown) : "";
+    for (const auto& range : ranges) {
+        if (!qKnown(range.first)) {
+            throw std::invalid_argument("Sensor '" + range.first + "' is not in " + filename);
+        }
     }
 
     if (!to_keep.empty()) {
         Sensors::tNames keepNames(to_keep.begin(), to_keep.end());
+        if (window.active()) keepNames.insert(timeSensor);
+        for (const auto& range : ranges) keepNames.insert(range.first);
         sensors.qKeep(keepNames);
     }
     if (!criteria.empty()) {
@@ -128,60 +700,110 @@ SingleFileResult parse_single_file(
     }
 
     KnownBytes kb(is);
-    size_t nBytes = size_t{1024} * 1024;
-    ColumnDataResult result = read_columns(is, kb, sensors, repair, nBytes);
-
-    size_t start = 0;
-    size_t n_records = result.n_records;
-    if (skip_first_record && n_records > 0) {
-        start = 1;
-        n_records -= 1;
+    const DecodePlan plan(sensors);
+    const RowFilter filter = make_row_filter(plan.sensorInfo, window, timeSensor, ranges);
+
+    if (sparse) {
+        const char* data = nullptr;
+        size_t n = 0;
+        if (!in.remaining(data, n)) {
+            throw std::runtime_error("Cannot read the data records of " + filename);
+        }
+        SparseColumnResult decoded = read_sparse_columns(data, n, kb, plan, repair);
+        const size_t start = (skip_first_record && decoded.n_records > 0) ? 1 : 0;
+        SingleFileResult result{nullptr, plan.sensorInfo, decoded.n_records - start,
+                                extract_header_fields(hdr), filename, true};
+        for (size_t oi = 0; oi < decoded.columns.size(); ++oi) {
+            result.sparse.push_back(empty_sparse(plan.sensorInfo[oi]));
+            append_sparse(result.sparse[oi], std::move(decoded.columns[oi]), start, 0);
+        }
+        if (!filter.empty()) {
+            result.n_records = filter_sparse(result.sparse, filter, result.n_records);
+        }
+        return result;
     }
 
+    size_t n_records = 0;
+    std::unique_ptr<ColumnArena> columns =
+        decode_columns(in, kb, sensors, plan, repair, skip_first_record, filter, n_records);
+
     return {
-        std::move(result.columns),
-        std::move(result.sensor_info),
+        std::move(columns),
+        plan.sensorInfo,
         n_records,
-        start,
         extract_header_fields(hdr),
         filename,
     };
 }
 
-void grow_union_columns(std::vector<TypedColumn>& cols,
-                        const std::vector<SensorInfo>& info,
-                        size_t new_capacity) {
-    for (auto& col : cols) {
-        std::visit([new_capacity](auto& vec) {
-            using T = typename std::decay_t<decltype(vec)>::value_type;
-            size_t old_size = vec.size();
-            if (new_capacity <= old_size) {
-                return;
-            }
-            vec.resize(new_capacity);
-            // Fill new elements with type-appropriate fill value
-            T fill;
-            if constexpr (std::is_same_v<T, int8_t>)       fill = FILL_INT8;
-            else if constexpr (std::is_same_v<T, int16_t>)  fill = FILL_INT16;
-            else if constexpr (std::is_same_v<T, float>)    fill = NAN;
-            else                                             fill = NAN;
-            std::fill(vec.begin() + old_size, vec.end(), fill);
-        }, col);
+// What pass 1 learned about a file, so later passes can go straight to
+// its data records without re-parsing the header and sensor list
+struct PassOneFile {
+    std::string filename;
+    std::string crc;
+    std::streamoff dataOffset = -1; // -1 if the known bytes were unreadable
+    bool qFlip = false;
+};
+
+// A pass-1 file's contents, loaded (and decompressed) ahead of decoding
+struct LoadedFile {
+    std::unique_ptr<DBDInput> input;
+    const char* data = nullptr; // First data record
+    size_t n = 0;
+
+    bool ok() const { return data != nullptr; }
+};
+
+LoadedFile load_data_section(const PassOneFile& f) {
+    LoadedFile out;
+    if (f.dataOffset < 0) return out;
+    try {
+        out.input = std::make_unique<DBDInput>(f.filename);
+        if (!out.input->span(f.dataOffset, out.data, out.n)) {
+            out.data = nullptr;
+        }
+    } catch (const std::exception&) {
+        out.data = nullptr;
     }
+    return out;
 }
 
-MultiFileResult parse_multiple_files(
+// Pass 1 of a multi-file read: the sorted files that passed the header
+// and mission checks, their merged sensor list, and the union columns
+struct MultiFileSetup {
+    std::unique_ptr<SensorsMap> smap;
+    std::vector<PassOneFile> files;
+    std::vector<SensorInfo> unionInfo;
+    std::string timeSensor; // A windowed read's time sensor
+    RowFilter filter;       // Over the union columns
+
+    // Decode plan of file k, or nullptr if its sensor list could not be
+    // loaded in pass 1
+    const DecodePlan* plan(size_t k) const {
+        try {
+            return &smap->plan(smap->find(files[k].crc));
+        } catch (const std::exception&) {
+            return nullptr;
+        }
+    }
+};
+
+MultiFileSetup setup_multiple_files(
     const std::vector<std::string>& filenames,
     const std::string& cache_dir,
     const std::vector<std::string>& to_keep,
     const std::vector<std::string>& criteria,
     const std::vector<std::string>& skip_missions,
     const std::vector<std::string>& keep_missions,
-    bool skip_first_record,
-    bool repair)
+    const TimeWindow& window = {},
+    const ValueRanges& ranges = {},
+    size_t n_threads = 1)
 {
+    const StageTimer timer(ReadStats::STAGE_SCAN);
+    MultiFileSetup setup;
+    setup.smap = std::make_unique<SensorsMap>(cache_dir);
     if (filenames.empty()) {
-        return {{}, {}, 0, 0};
+        return setup;
     }
 
     std::vector<std::string> sorted_files(filenames);
@@ -191,30 +813,60 @@ MultiFileResult parse_multiple_files(
     for (const auto& m : skip_missions) Header::addMission(m, skipSet);
     for (const auto& m : keep_missions) Header::addMission(m, keepSet);
 
-    // Pass 1: scan headers, build SensorsMap
-    SensorsMap smap(cache_dir);
-    std::vector<std::string> valid_files;
-
-    for (const auto& fn : sorted_files) {
-        try {
-            DecompressTWR is(fn, qCompressed(fn));
-            if (!is) continue;
-            Header hdr(is, fn.c_str());
-            if (hdr.empty()) continue;
-            if (!hdr.qProcessMission(skipSet, keepSet)) continue;
-            smap.insert(is, hdr, true);
-            valid_files.push_back(fn);
-        } catch (const std::exception&) {
-            continue;
-        }
+    // Scan headers, build SensorsMap, and note where each file's data
+    // records start; files are scanned concurrently into slots kept in
+    // sorted order
+    SensorsMap& smap = *setup.smap;
+    std::vector<PassOneFile>& valid_files = setup.files;
+
+    std::vector<std::optional<PassOneFile>> slots(sorted_files.size());
+    parallel_for(slots.size(), resolve_threads(n_threads, slots.size()), [&](size_t i) {
+        const std::string& fn = sorted_files[i];
+        slots[i] = scan_head(fn, [&](std::istream& is) -> std::optional<PassOneFile> {
+            try {
+                if (!is) return std::nullopt;
+                Header hdr(is, fn.c_str());
+                if (hdr.empty()) return std::nullopt;
+                if (!hdr.qProcessMission(skipSet, keepSet)) return std::nullopt;
+                smap.insert(is, hdr, true);
+                PassOneFile f{fn, hdr.crc()};
+                try {
+                    const KnownBytes kb(is);
+                    f.dataOffset = is.tellg();
+                    f.qFlip = kb.qFlip();
+                } catch (const std::exception&) {
+                    // Still counted as a file, but no data is read from it
+                }
+                return f;
+            } catch (const std::exception&) {
+                return std::nullopt;
+            }
+        });
+    });
+    for (auto& f : slots) {
+        if (f) valid_files.push_back(std::move(*f));
     }
 
     if (valid_files.empty()) {
-        return {{}, {}, 0, 0};
+        return setup;
+    }
+
+    // Sensors rows are selected by are always decoded, and so output
+    const auto qKnown = [&smap](const std::string& name) { return smap.qSensor(name); };
+    if (window.active()) {
+        if (!smap.qAnySensors()) return setup; // No times, so nothing to filter on
+        setup.timeSensor = resolve_time_sensor(window, qKnown);
+    }
+    for (const auto& range : ranges) {
+        if (!qKnown(range.first)) {
+            throw std::invalid_argument("Sensor '" + range.first + "' is not in any file");
+        }
     }
 
     if (!to_keep.empty()) {
         Sensors::tNames keepNames(to_keep.begin(), to_keep.end());
+        if (window.active()) keepNames.insert(setup.timeSensor);
+        for (const auto& range : ranges) keepNames.insert(range.first);
         smap.qKeep(keepNames);
     }
     if (!criteria.empty()) {
@@ -225,120 +877,802 @@ MultiFileResult parse_multiple_files(
     smap.setUpForData();
     const Sensors& allSensors = smap.allSensors();
 
-    const size_t nOut = allSensors.nToStore();
-    std::vector<SensorInfo> unionInfo(nOut);
-    for (size_t i = 0; i < allSensors.size(); ++i) {
-        const Sensor& s = allSensors[i];
-        if (s.qKeep()) {
-            size_t idx = static_cast<size_t>(s.index());
-            if (idx < nOut) {
-                unionInfo[idx] = {s.name(), s.units(), s.size()};
+    const size_t nOut = allSensors.nToStore();
+    std::vector<SensorInfo>& unionInfo = setup.unionInfo;
+    unionInfo.resize(nOut);
+    for (size_t i = 0; i < allSensors.size(); ++i) {
+        const Sensor& s = allSensors[i];
+        if (s.qKeep()) {
+            size_t idx = static_cast<size_t>(s.index());
+            if (idx < nOut) {
+                unionInfo[idx] = {s.name(), s.units(), s.size()};
+            }
+        }
+    }
+
+    setup.filter = make_row_filter(unionInfo, window, setup.timeSensor, ranges);
+    return setup;
+}
+
+// Write the record index entry of a pass-1 file from its loaded data.
+// The record and time counts do not depend on the read's settings: every
+// complete record is counted, resyncing past bad tags, and every new value
+// of the time sensor is in the range. Failing to write it is not an error.
+void index_file(const PassOneFile& f, const LoadedFile& file, const DecodePlan& plan,
+                const MultiFileSetup& setup, const std::string& cache_dir) {
+    RecordIndexEntry entry;
+    if (!RecordIndex::identify(f.filename, entry)) return;
+
+    const Sensors& sensors = setup.smap->find(f.crc);
+    size_t sensor = sensors.size();
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        if (sensors[i].name() == setup.timeSensor) {
+            sensor = i;
+            break;
+        }
+    }
+
+    const RecordSummary sum = summarize_records(file.data, file.n, KnownBytes(f.qFlip),
+                                                plan, sensor, true);
+    entry.dataOffset = f.dataOffset;
+    entry.nRecords = sum.nRecords;
+    entry.timeSensor = setup.timeSensor;
+    entry.nTimes = sum.nValues;
+    entry.tMin = sum.lo;
+    entry.tMax = sum.hi;
+    RecordIndex::save(cache_dir, entry);
+}
+
+// A sparse multi-file read: each file is decoded on its own by the sparse
+// kernel, without a record pre-scan, and appended to the union columns in
+// order, dropping first records and filtering as parse_multiple_files
+// does. The record index is neither consulted nor written.
+MultiFileResult parse_sparse_files(const MultiFileSetup& setup,
+                                   bool skip_first_record,
+                                   bool repair,
+                                   size_t n_threads)
+{
+    const std::vector<PassOneFile>& valid_files = setup.files;
+    const std::vector<SensorInfo>& unionInfo = setup.unionInfo;
+    const size_t nFiles = valid_files.size();
+    const size_t nThreads = resolve_threads(n_threads, nFiles);
+
+    std::vector<std::optional<SparseColumnResult>> decoded(nFiles);
+    pipeline_for(nFiles, nThreads, nThreads + 1,
+        [&](size_t k) { return load_data_section(valid_files[k]); },
+        [&](size_t k, LoadedFile file) {
+            const DecodePlan* plan = file.ok() ? setup.plan(k) : nullptr;
+            if (!plan || !plan->fits(unionInfo)) return;
+            decoded[k] = read_sparse_columns(file.data, file.n, KnownBytes(valid_files[k].qFlip),
+                                             *plan, repair);
+        });
+
+    MultiFileResult result{nullptr, unionInfo, 0, nFiles, true};
+    for (const SensorInfo& si : unionInfo) result.sparse.push_back(empty_sparse(si));
+    size_t fileCount = 0;
+    for (auto& file : decoded) {
+        if (!file) continue;
+        const size_t start = (skip_first_record && fileCount > 0 && file->n_records > 0) ? 1 : 0;
+        for (size_t oi = 0; oi < file->columns.size(); ++oi) {
+            if (file->sensor_info[oi].name.empty()) continue; // Not in this file
+            append_sparse(result.sparse[oi], std::move(file->columns[oi]), start, result.n_records);
+        }
+        result.n_records += file->n_records - start;
+        ++fileCount;
+        file.reset();
+    }
+    if (!setup.filter.empty()) {
+        result.n_records = filter_sparse(result.sparse, setup.filter, result.n_records);
+    }
+    return result;
+}
+
+// Bytes of decompressed files a multi-file read keeps from its record
+// pre-scan for the decode pass, instead of decompressing them twice
+constexpr size_t MAX_KEPT_DECOMPRESSED = size_t(1) << 30;
+
+MultiFileResult parse_multiple_files(
+    const std::vector<std::string>& filenames,
+    const std::string& cache_dir,
+    const std::vector<std::string>& to_keep,
+    const std::vector<std::string>& criteria,
+    const std::vector<std::string>& skip_missions,
+    const std::vector<std::string>& keep_missions,
+    bool skip_first_record,
+    bool repair,
+    size_t n_threads,
+    const TimeWindow& window = {},
+    const ValueRanges& ranges = {},
+    bool sparse = false,
+    bool column_cache = false)
+{
+    if (column_cache && cache_dir.empty()) {
+        throw std::invalid_argument("column_cache needs a cache_dir");
+    }
+    MultiFileSetup setup = setup_multiple_files(filenames, cache_dir, to_keep,
+                                                criteria, skip_missions, keep_missions,
+                                                window, ranges, n_threads);
+    const std::vector<PassOneFile>& valid_files = setup.files;
+    const std::vector<SensorInfo>& unionInfo = setup.unionInfo;
+    const RowFilter& filter = setup.filter;
+
+    if (valid_files.empty()) {
+        return {{}, {}, 0, 0, sparse};
+    }
+    if (window.active() && setup.timeSensor.empty()) { // No sensors, so no record has a time
+        return {{}, {}, 0, valid_files.size(), sparse};
+    }
+    if (sparse) {
+        return parse_sparse_files(setup, skip_first_record, repair, n_threads);
+    }
+
+    // Both remaining passes are pipelined: a loader thread reads and
+    // decompresses files in order, up to `depth` ahead, while nThreads
+    // workers scan or decode the ones already loaded.
+    const size_t nFiles = valid_files.size();
+    const size_t nThreads = resolve_threads(n_threads, nFiles);
+    const size_t depth = nThreads + 1;
+
+    std::vector<char> usable(nFiles, 0);
+    std::vector<size_t> fileRecords(nFiles, 0);
+    std::vector<char> firstKept(nFiles, 0); // The file's first record is a row
+
+    // With a time window and a cache directory, a file whose record index
+    // puts all of its times outside the window is not read at all. It is
+    // still a usable file for skip_first_record, with no records.
+    const bool qIndex = window.active() && !cache_dir.empty();
+    std::vector<char> indexed(nFiles, 0);
+
+    // With column_cache, a file with a column cache file is not read at
+    // all: its rows are copied from the mapped columns. One without is
+    // cached once it is counted, and then copied the same way.
+    const bool qColumns = column_cache && filter.empty() && criteria.empty();
+    std::vector<ColumnCache::tPtr> cached(nFiles);
+    if (qColumns) {
+        parallel_for(nFiles, nThreads, [&](size_t k) {
+            const PassOneFile& f = valid_files[k];
+            const DecodePlan* plan = f.dataOffset < 0 ? nullptr : setup.plan(k);
+            if (!plan || !plan->fits(unionInfo)) return;
+            ColumnCache::tPtr cache = ColumnCache::load(cache_dir, f.filename, f.crc, repair);
+            if (!cache || !covers(*cache, *plan)) return;
+            cached[k] = std::move(cache);
+            fileRecords[k] = cached[k]->nRecords();
+            firstKept[k] = fileRecords[k] > 0;
+            usable[k] = 1;
+        });
+    }
+
+    std::vector<size_t> toCount;
+    for (size_t k = 0; k < nFiles; ++k) {
+        if (cached[k]) {
+            ReadStats::add(ReadStats::COLUMN_CACHE_HITS, 1);
+            continue;
+        } else if (qColumns) {
+            ReadStats::add(ReadStats::COLUMN_CACHE_MISSES, 1);
+        }
+        RecordIndexEntry entry;
+        if (qIndex && RecordIndex::load(cache_dir, valid_files[k].filename, entry)
+                && entry.timeSensor == setup.timeSensor) {
+            indexed[k] = 1;
+            ReadStats::add(ReadStats::RECORD_INDEX_HITS, 1);
+            if (!window.overlaps(entry.tMin, entry.tMax)) {
+                const DecodePlan* plan = valid_files[k].dataOffset < 0 ? nullptr : setup.plan(k);
+                usable[k] = plan && plan->fits(unionInfo);
+                continue;
+            }
+        } else if (qIndex) {
+            ReadStats::add(ReadStats::RECORD_INDEX_MISSES, 1);
+        }
+        toCount.push_back(k);
+    }
+
+    // Pre-scan every file's record boundaries, or with a filter the rows
+    // that pass it. A file whose sensor sizes disagree with the union is
+    // dropped, as it always has been. Decompressed files are kept for the
+    // decode pass while they fit in MAX_KEPT_DECOMPRESSED.
+    std::vector<LoadedFile> kept(nFiles);
+    std::atomic<size_t> keptBytes{0};
+    pipeline_for(toCount.size(), nThreads, depth,
+        [&](size_t j) { return load_data_section(valid_files[toCount[j]]); },
+        [&](size_t j, LoadedFile file) {
+            const size_t k = toCount[j];
+            const DecodePlan* plan = file.ok() ? setup.plan(k) : nullptr;
+            if (!plan || !plan->fits(unionInfo)) return;
+            if (filter.empty()) {
+                fileRecords[k] = count_records(file.data, file.n, *plan, repair);
+                firstKept[k] = fileRecords[k] > 0;
+            } else {
+                bool qFirst = false;
+                fileRecords[k] = count_records(file.data, file.n, KnownBytes(valid_files[k].qFlip),
+                                               *plan, repair, filter, qFirst);
+                firstKept[k] = qFirst;
+            }
+            usable[k] = 1;
+            if (qIndex && !indexed[k]) {
+                index_file(valid_files[k], file, *plan, setup, cache_dir);
+            }
+            if (qColumns) {
+                const PassOneFile& f = valid_files[k];
+                ColumnCache::tPtr cache = write_column_cache(cache_dir, f.filename,
+                                                             setup.smap->find(f.crc), file.data,
+                                                             file.n, KnownBytes(f.qFlip), repair);
+                if (cache && covers(*cache, *plan)) cached[k] = std::move(cache);
+            }
+            if (!cached[k] && file.input->qDecompressed()) {
+                const size_t n = file.input->size();
+                if (keptBytes.fetch_add(n) + n <= MAX_KEPT_DECOMPRESSED) {
+                    kept[k] = std::move(file);
+                } else {
+                    keptBytes -= n;
+                }
+            }
+        });
+
+    // Ordered prefix sum: each file gets a disjoint slice of the union
+    // columns, and skip_first_record applies to every file after the first
+    // one that was successfully read, so the output is identical to a
+    // serial read regardless of thread count. Dropping a first record that
+    // a filter rejects anyway changes nothing, so it is left to the filter.
+    std::vector<size_t> starts(nFiles, 0), counts(nFiles, 0), offsets(nFiles, 0);
+    size_t totalRecords = 0;
+    size_t fileCount = 0;
+    for (size_t k = 0; k < nFiles; ++k) {
+        offsets[k] = totalRecords;
+        if (!usable[k]) continue;
+        size_t n = fileRecords[k];
+        if (skip_first_record && fileCount > 0 && firstKept[k]) {
+            starts[k] = 1;
+            n -= 1;
+        }
+        counts[k] = n;
+        totalRecords += n;
+        ++fileCount;
+    }
+
+    // Allocate the union columns once, at their final size
+    auto unionColumns = std::make_unique<ColumnArena>(unionInfo, totalRecords);
+    const std::vector<void*> unionPtrs = unionColumns->pointers();
+
+    // Pass 2: decode every file straight into its slice. Records beyond a
+    // file's counted slice (only if it changed on disk since the pre-scan)
+    // are dropped rather than spilling into the next file's rows.
+    std::vector<size_t> toDecode, toCopy;
+    for (size_t k = 0; k < nFiles; ++k) {
+        if (counts[k] == 0 || cached[k]) kept[k] = LoadedFile();
+        if (counts[k] > 0) (cached[k] ? toCopy : toDecode).push_back(k);
+    }
+    parallel_for(toCopy.size(), resolve_threads(n_threads, toCopy.size()), [&](size_t j) {
+        const size_t k = toCopy[j];
+        const ColumnSink sink{unionPtrs.data(), offsets[k], starts[k], counts[k]};
+        read_cached(*cached[k], *setup.plan(k), sink);
+        cached[k].reset();
+    });
+    pipeline_for(toDecode.size(), nThreads, depth,
+        [&](size_t j) {
+            const size_t k = toDecode[j];
+            return kept[k].ok() ? std::move(kept[k]) : load_data_section(valid_files[k]);
+        },
+        [&](size_t j, LoadedFile file) {
+            const size_t k = toDecode[j];
+            const DecodePlan* plan = file.ok() ? setup.plan(k) : nullptr;
+            if (!plan) return;
+            const ColumnSink sink{unionPtrs.data(), offsets[k], starts[k], counts[k]};
+            const KnownBytes kb(valid_files[k].qFlip);
+            if (filter.empty()) {
+                read_columns(file.data, file.n, kb, *plan, repair, sink);
+            } else {
+                read_columns(file.data, file.n, kb, *plan, repair, sink, filter);
+            }
+        });
+
+    return {
+        std::move(unionColumns),
+        setup.unionInfo,
+        totalRecords,
+        valid_files.size(),
+    };
+}
+
+// Streams the records of a multi-file read in chunks of at most chunkSize
+// rows, in the same order and with the same values as parse_multiple_files.
+// Only the current file is held; each chunk is decoded into an arena the
+// caller supplies and hands on, whose memory comes back through the arena
+// pool once the chunk is released. Each window of a file is decoded
+// straight into the chunk through a ColumnSink, and a DecodeCursor carries
+// the file's position and repeat values from one window to the next.
+class ChunkReader {
+    MultiFileSetup mSetup;
+    bool mSkipFirst;
+    bool mRepair;
+    size_t mChunkSize;
+
+    size_t mNext = 0;      // Next file to open
+    size_t mFileCount = 0; // Files read so far, for skip_first_record
+    LoadedFile mFile;      // File being emitted
+    const DecodePlan* mPlan = nullptr;
+    DecodeCursor mCursor;
+    size_t mFileRow = 0;   // Next record of mFile to emit
+    size_t mFileEnd = 0;   // Records in mFile
+    std::mutex mMutex;
+
+    // Advance to the next file with records to emit; false at the end
+    bool open_next() {
+        mFile = LoadedFile();
+        while (mNext < mSetup.files.size()) {
+            const size_t k = mNext++;
+            LoadedFile file = load_data_section(mSetup.files[k]);
+            const DecodePlan* plan = file.ok() ? mSetup.plan(k) : nullptr;
+            if (!plan || !plan->fits(mSetup.unionInfo)) continue;
+            const size_t n = count_records(file.data, file.n, *plan, mRepair);
+            const size_t start = (mSkipFirst && mFileCount > 0 && n > 0) ? 1 : 0;
+            ++mFileCount;
+            if (n <= start) continue;
+            mFile = std::move(file);
+            mPlan = plan;
+            mCursor = DecodeCursor();
+            mFileRow = start;
+            mFileEnd = n;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    ChunkReader(MultiFileSetup&& setup, size_t chunkSize, bool skipFirst, bool repair)
+        : mSetup(std::move(setup))
+        , mSkipFirst(skipFirst)
+        , mRepair(repair)
+        , mChunkSize(chunkSize)
+    {
+        if (mChunkSize == 0) {
+            throw std::invalid_argument("chunk_size must be positive");
+        }
+    }
+
+    ChunkReader(const ChunkReader&) = delete;
+    ChunkReader& operator=(const ChunkReader&) = delete;
+
+    // Held across fill() when shared between threads
+    std::mutex& mutex() { return mMutex; }
+
+    // Union columns for one chunk, set to their fill values
+    std::unique_ptr<ColumnArena> make_chunk() const {
+        return std::make_unique<ColumnArena>(mSetup.unionInfo, mChunkSize);
+    }
+
+    // Decode up to chunkSize records into chunk (from make_chunk); returns
+    // the number of rows, 0 once all records are read
+    size_t fill(ColumnArena& chunk) {
+        if (mSetup.unionInfo.empty()) {
+            return 0;
+        }
+        const std::vector<void*> ptrs = chunk.pointers();
+        size_t rows = 0;
+        while (rows < mChunkSize) {
+            if (mFileRow >= mFileEnd && !open_next()) {
+                break;
+            }
+            const size_t n = std::min(mFileEnd - mFileRow, mChunkSize - rows);
+            const ColumnSink sink{ptrs.data(), rows, mFileRow, n};
+            const PassOneFile& f = mSetup.files[mNext - 1];
+            read_columns(mFile.data, mFile.n, KnownBytes(f.qFlip), *mPlan, mRepair, sink, mCursor);
+            rows += n;
+            mFileRow += n;
+        }
+        if (mFileRow >= mFileEnd) {
+            mFile = LoadedFile(); // Release the last file as soon as it is done
+        }
+        return rows;
+    }
+
+    const std::vector<SensorInfo>& sensor_info() const { return mSetup.unionInfo; }
+    size_t n_files() const { return mSetup.files.size(); }
+    size_t chunk_size() const { return mChunkSize; }
+};
+
+// Reads a file that is still being written, such as a live .sbd/.tbd, a
+// piece at a time: each read() returns only the records completed since
+// the last one. The header, sensor list, known bytes and decode plan are
+// parsed once. A DecodeCursor carries the data position and the repeat
+// values from read to read, so the pieces concatenate to a single read of
+// the file as it then stands. A compressed file keeps its decompressed
+// contents, and each read decodes only the LZ4 blocks appended since.
+class AppendReader {
+    std::string mFilename;
+    bool mSkipFirst;
+    bool mRepair;
+    bool mqCompressed;
+    HeaderFields mHeader;
+    std::unique_ptr<DecodePlan> mPlan;
+    size_t mDataOffset = 0; // Of the first data record in the contents
+    bool mqFlip = false;
+
+    DecodeCursor mCursor;
+    size_t mRows = 0;                // Rows returned so far
+    std::vector<char> mContents;     // Decompressed so far, if compressed
+    size_t mLength = 0;              // of which in use
+    size_t mRawUsed = 0;             // Compressed bytes they came from
+    std::mutex mMutex;
+
+    // The file's contents as they stand now; bytes keeps a mapping alive
+    bool contents(std::unique_ptr<ByteSource>& bytes, const char*& data, size_t& n) {
+        bytes = std::make_unique<ByteSource>(mFilename);
+        if (!bytes->isOpen()) return false;
+        if (!mqCompressed) {
+            data = bytes->data();
+            n = bytes->size();
+            return true;
+        }
+        if (bytes->size() < mRawUsed) return false;
+        size_t used = 0;
+        mLength = decompressTWR(bytes->data() + mRawUsed, bytes->size() - mRawUsed,
+                                mContents, mLength, used);
+        mRawUsed += used;
+        data = mContents.data();
+        n = mLength;
+        return true;
+    }
+
+public:
+    AppendReader(const std::string& filename,
+                 const std::string& cache_dir,
+                 const std::vector<std::string>& to_keep,
+                 const std::vector<std::string>& criteria,
+                 bool skipFirst,
+                 bool repair)
+        : mFilename(filename)
+        , mSkipFirst(skipFirst)
+        , mRepair(repair)
+        , mqCompressed(qCompressed(filename))
+    {
+        DBDInput in(filename);
+        std::istream& is = in.stream();
+        if (!is) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+
+        Header hdr(is, filename.c_str());
+        if (hdr.empty()) {
+            throw std::runtime_error("Empty or invalid header in " + filename);
+        }
+        mHeader = extract_header_fields(hdr);
+
+        Sensors sensors = read_sensors(is, hdr, filename, cache_dir);
+        if (!to_keep.empty()) {
+            Sensors::tNames keepNames(to_keep.begin(), to_keep.end());
+            sensors.qKeep(keepNames);
+        }
+        if (!criteria.empty()) {
+            Sensors::tNames critNames(criteria.begin(), criteria.end());
+            sensors.qCriteria(critNames);
+        }
+
+        const KnownBytes kb(is);
+        const std::streamoff pos = is.tellg();
+        if (pos < 0) {
+            throw std::runtime_error("Cannot find the data records of " + filename);
+        }
+        mDataOffset = static_cast<size_t>(pos);
+        mqFlip = kb.qFlip();
+        mPlan = std::make_unique<DecodePlan>(sensors);
+    }
+
+    AppendReader(const AppendReader&) = delete;
+    AppendReader& operator=(const AppendReader&) = delete;
+
+    // Held across read() when shared between threads
+    std::mutex& mutex() { return mMutex; }
+
+    // The records completed since the last call (all of them, the first
+    // time); a record still being written is left for the next call
+    SingleFileResult read() {
+        std::unique_ptr<ByteSource> bytes;
+        const char* file = nullptr;
+        size_t size = 0;
+        if (!contents(bytes, file, size) || size < mDataOffset + mCursor.pos) {
+            throw std::runtime_error("Cannot read " + mFilename + ", or it is shorter than when last read");
+        }
+        const char* data = file + mDataOffset;
+        const char* fresh = data + mCursor.pos;
+        const size_t nFresh = complete_bytes(fresh, size - mDataOffset - mCursor.pos, *mPlan, mRepair);
+        const size_t count = count_records(fresh, nFresh, *mPlan, mRepair);
+
+        // skip_first_record drops record 0, whichever read it comes in
+        const size_t total = mCursor.nRows + count;
+        const size_t start = std::max<size_t>(mCursor.nRows, mSkipFirst ? 1 : 0);
+        const size_t rows = total > start ? total - start : 0;
+
+        auto columns = std::make_unique<ColumnArena>(mPlan->sensorInfo, rows);
+        if (count > 0) {
+            // Stops after the last counted record, so the unkept records
+            // after it are decoded with the row they belong to, next time
+            const std::vector<void*> ptrs = columns->pointers();
+            read_columns(data, mCursor.pos + nFresh, KnownBytes(mqFlip), *mPlan, mRepair,
+                         ColumnSink{ptrs.data(), 0, start, rows}, mCursor);
+        }
+        mRows += rows;
+        return {std::move(columns), mPlan->sensorInfo, rows, mHeader, mFilename};
+    }
+
+    const std::string& filename() const { return mFilename; }
+    size_t n_records() const { return mRows; }
+    size_t offset() const { return mDataOffset + mCursor.pos; }
+};
+
+// A file read one request at a time, for callers that ask for a few
+// sensors at once: the file is loaded and its header and sensor list
+// parsed once, and one pass with every sensor kept indexes where each
+// column's values lie (index_columns). Each read() then loads only the
+// values of the sensors asked for, straight from that index, and gives
+// the named columns read_dbd_file would for the same to_keep, without the
+// unnamed columns filling the gaps in its layout. A file whose sensor
+// list has a size a column cannot hold, which ends decoding only when
+// that sensor is kept, is decoded anew for each read instead.
+class IndexedReader {
+    std::string mFilename;
+    bool mSkipFirst;
+    bool mRepair;
+    HeaderFields mHeader;
+    Sensors mSensors;
+    std::unique_ptr<DBDInput> mInput;
+    const char* mData = nullptr; // First data record
+    size_t mSize = 0;
+    bool mqFlip = false;
+    std::unique_ptr<DecodePlan> mPlan; // Every sensor kept
+    SectionIndex mIndex;
+    bool mqIndexed = false;
+
+public:
+    IndexedReader(const std::string& filename,
+                  const std::string& cache_dir,
+                  const std::vector<std::string>& criteria,
+                  bool skipFirst,
+                  bool repair)
+        : mFilename(filename)
+        , mSkipFirst(skipFirst)
+        , mRepair(repair)
+        , mInput(std::make_unique<DBDInput>(filename))
+    {
+        std::istream& is = mInput->stream();
+        if (!is) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+
+        Header hdr(is, filename.c_str());
+        if (hdr.empty()) {
+            throw std::runtime_error("Empty or invalid header in " + filename);
+        }
+        mHeader = extract_header_fields(hdr);
+
+        mSensors = read_sensors(is, hdr, filename, cache_dir);
+        if (!criteria.empty()) {
+            Sensors::tNames critNames(criteria.begin(), criteria.end());
+            mSensors.qCriteria(critNames);
+        }
+
+        const KnownBytes kb(is);
+        mqFlip = kb.qFlip();
+        if (!mInput->remaining(mData, mSize)) {
+            throw std::runtime_error("Cannot read the data records of " + filename);
+        }
+        mPlan = std::make_unique<DecodePlan>(mSensors);
+        mqIndexed = std::none_of(mPlan->stop.begin(), mPlan->stop.end(),
+                                 [](uint8_t q) { return q != 0; });
+        if (mqIndexed) {
+            mIndex = index_columns(mData, mSize, *mPlan, mRepair);
+        }
+    }
+
+    IndexedReader(const IndexedReader&) = delete;
+    IndexedReader& operator=(const IndexedReader&) = delete;
+
+    // The columns of the sensors in to_keep (all of them if empty), in the
+    // order read_dbd_file gives them
+    SingleFileResult read(const std::vector<std::string>& to_keep) const {
+        const Sensors::tNames keepNames(to_keep.begin(), to_keep.end());
+        if (!mqIndexed) {
+            Sensors sensors = mSensors;
+            if (!keepNames.empty()) sensors.qKeep(keepNames);
+            const DecodePlan plan(sensors);
+            std::vector<SensorInfo> info;
+            for (const SensorInfo& si : plan.sensorInfo) {
+                if (!si.name.empty()) info.push_back(si);
+            }
+            const size_t total = count_records(mData, mSize, plan, mRepair);
+            const size_t start = (mSkipFirst && total > 0) ? 1 : 0;
+            auto columns = std::make_unique<ColumnArena>(info, total - start);
+
+            // Gaps in the plan's layout are never written
+            std::vector<void*> ptrs(plan.nOut(), nullptr);
+            for (size_t oi = 0, i = 0; oi < plan.nOut(); ++oi) {
+                if (!plan.sensorInfo[oi].name.empty()) ptrs[oi] = columns->data(i++);
+            }
+            read_columns(mData, mSize, KnownBytes(mqFlip), plan, mRepair,
+                         ColumnSink{ptrs.data(), 0, start, total - start});
+            return {std::move(columns), std::move(info), total - start, mHeader, mFilename};
+        }
+
+        // The named columns for to_keep, in the order of their Sensor::index()
+        std::vector<size_t> cols;
+        std::vector<SensorInfo> info;
+        for (size_t oi = 0; oi < mPlan->nOut(); ++oi) {
+            const SensorInfo& si = mPlan->sensorInfo[oi];
+            if (!si.name.empty() && (keepNames.empty() || keepNames.count(si.name))) {
+                cols.push_back(oi);
+                info.push_back(si);
             }
         }
-    }
 
-    // Pass 2: read each file, copy into union columns, discard per-file data
-    // Build name-to-index map for O(1) lookup during merge
-    std::unordered_map<std::string, int> unionNameIndex;
-    for (size_t i = 0; i < nOut; ++i) {
-        unionNameIndex[unionInfo[i].name] = static_cast<int>(i);
+        const StageTimer timer(ReadStats::STAGE_DECODE);
+        const size_t total = mIndex.n_records;
+        const size_t start = (mSkipFirst && total > 0) ? 1 : 0;
+        auto columns = std::make_unique<ColumnArena>(info, total - start);
+        for (size_t i = 0; i < cols.size(); ++i) {
+            gather_column(mData, mqFlip, mIndex.columns[cols[i]], info[i].size, start,
+                          columns->data(i), total - start);
+        }
+        return {std::move(columns), std::move(info), total - start, mHeader, mFilename};
     }
 
-    // Allocate union columns with initial capacity estimate
-    size_t capacity = valid_files.size() * 8192;
-    std::vector<TypedColumn> unionColumns(nOut);
-    for (size_t i = 0; i < nOut; ++i) {
-        switch (unionInfo[i].size) {
-            case 1: unionColumns[i] = std::vector<int8_t>(capacity, FILL_INT8); break;
-            case 2: unionColumns[i] = std::vector<int16_t>(capacity, FILL_INT16); break;
-            case 4: unionColumns[i] = std::vector<float>(capacity, NAN); break;
-            case 8: unionColumns[i] = std::vector<double>(capacity, NAN); break;
-            default: unionColumns[i] = std::vector<double>(capacity, NAN); break;
-        }
+    const std::string& filename() const { return mFilename; }
+    size_t n_records() const {
+        const size_t total = mqIndexed ? mIndex.n_records : count_records(mData, mSize, *mPlan, mRepair);
+        return (mSkipFirst && total > 0) ? total - 1 : total;
     }
+};
 
-    size_t offset = 0;
-    size_t fileCount = 0;
+#ifdef HAVE_NETCDF
+// One NetCDF file of a multi-output write and the sensors it holds; an
+// empty to_keep means every sensor
+struct NetCDFOutput {
+    std::string filename;
+    std::vector<std::string> to_keep;
+};
 
-    for (const auto& fn : valid_files) {
-        try {
-            DecompressTWR is(fn, qCompressed(fn));
-            if (!is) continue;
-            Header hdr(is, fn.c_str());
-            if (hdr.empty()) continue;
-            const Sensors& fileSensors = smap.find(hdr);
-            // Skip inline sensor lines for unfactored files (pass 1 consumed
-            // them via Sensors(is,hdr), but find() does no stream I/O).
-            if (!hdr.qFactored()) {
-                for (int i = hdr.nSensors(); i > 0; --i) {
-                    std::string line;
-                    std::getline(is, line);
-                }
+// Bytes of decoded chunks a NetCDF write holds by default, and the most
+// chunks it decodes ahead of the writer whatever the budget
+constexpr size_t DEFAULT_WRITE_BUDGET = size_t(256) << 20;
+constexpr size_t MAX_WRITE_CHUNKS = 8;
+
+// A multi-file read streamed into several NetCDF-4 files a chunk at a
+// time. The files are scanned, loaded and decoded once, with the union of
+// the outputs' sensors as the SensorsMap plan, and each output is written
+// from its columns of every chunk. A producer thread decodes into a fixed
+// set of chunk arenas while the calling thread writes the ones it has
+// filled, in order, and hands them back: as many chunks as memory_budget
+// bytes hold (2 to MAX_WRITE_CHUNKS), with the chunk shortened from
+// chunk_size rows if two would not fit. Memory is then bounded by the
+// budget and one loaded file however many files and outputs there are. A
+// budget of 0 decodes and writes one chunk in turn on the calling thread.
+// Returns the records and files written to each output; like the Python
+// writer, creates no file for an output when no files or none of its
+// sensors are selected.
+std::vector<std::pair<size_t, size_t>> write_netcdf_outputs(
+    const std::vector<std::string>& filenames,
+    const std::vector<NetCDFOutput>& outputs,
+    const std::string& cache_dir,
+    const std::vector<std::string>& criteria,
+    const std::vector<std::string>& skip_missions,
+    const std::vector<std::string>& keep_missions,
+    bool skip_first_record,
+    bool repair,
+    int compression,
+    size_t chunk_size,
+    size_t n_threads,
+    size_t memory_budget)
+{
+    std::vector<std::pair<size_t, size_t>> written(outputs.size(), {0, 0});
+
+    // Decode every sensor any output keeps; one keeping all keeps all
+    std::vector<std::string> unionKeep;
+    {
+        Sensors::tNames seen;
+        for (const NetCDFOutput& out : outputs) {
+            if (out.to_keep.empty()) {
+                unionKeep.clear();
+                break;
             }
-            KnownBytes kb(is);
-            ColumnDataResult result = read_columns(is, kb, fileSensors, repair, 1024 * 1024);
-
-            size_t n = result.n_records;
-            size_t start = 0;
-            if (skip_first_record && fileCount > 0 && n > 0) {
-                start = 1;
-                n -= 1;
+            for (const std::string& name : out.to_keep) {
+                if (seen.insert(name).second) unionKeep.push_back(name);
             }
+        }
+    }
 
-            if (n > 0) {
-                // Grow union columns if needed (doubling strategy)
-                if (offset + n > capacity) {
-                    capacity = std::max(offset + n, capacity * 2);
-                    grow_union_columns(unionColumns, unionInfo, capacity);
-                }
+    MultiFileSetup setup = setup_multiple_files(filenames, cache_dir, unionKeep, criteria,
+                                                skip_missions, keep_missions, {}, {}, n_threads);
+    if (outputs.empty() || setup.files.empty() || setup.unionInfo.empty()) {
+        return written;
+    }
 
-                // Copy from per-file result into union columns
-                for (size_t ci = 0; ci < result.columns.size(); ++ci) {
-                    const std::string& name = result.sensor_info[ci].name;
-                    auto it = unionNameIndex.find(name);
-                    if (it == unionNameIndex.end()) continue;
-                    int unionIdx = it->second;
-
-                    std::visit([offset, start, n, unionIdx, &unionColumns](const auto& src_vec) {
-                        using T = typename std::decay_t<decltype(src_vec)>::value_type;
-                        auto& dst_vec = std::get<std::vector<T>>(unionColumns[unionIdx]);
-                        for (size_t r = 0; r < n; ++r) {
-                            dst_vec[offset + r] = src_vec[start + r];
-                        }
-                    }, result.columns[ci]);
-                }
-                offset += n;
-            }
-            ++fileCount;
-            // result goes out of scope here — per-file memory freed immediately
-        } catch (const std::exception&) {
-            continue;
+    // The union columns of each output, in union order as a read of that
+    // output's sensors alone would give them
+    std::vector<std::vector<size_t>> columns(outputs.size());
+    for (size_t k = 0; k < outputs.size(); ++k) {
+        const Sensors::tNames keep(outputs[k].to_keep.begin(), outputs[k].to_keep.end());
+        for (size_t i = 0; i < setup.unionInfo.size(); ++i) {
+            if (keep.empty() || keep.count(setup.unionInfo[i].name)) columns[k].push_back(i);
         }
     }
 
-    // Trim union columns to actual size
-    size_t totalRecords = offset;
-    for (size_t i = 0; i < nOut; ++i) {
-        std::visit([totalRecords](auto& vec) {
-            vec.resize(totalRecords);
-            vec.shrink_to_fit();
-        }, unionColumns[i]);
+    size_t nChunks = 1;
+    if (memory_budget > 0) {
+        size_t rowBytes = 0;
+        for (const SensorInfo& si : setup.unionInfo) {
+            rowBytes += ColumnArena::element_size(column_kind(si.size));
+        }
+        chunk_size = std::max<size_t>(1, std::min(chunk_size, memory_budget / (2 * rowBytes)));
+        nChunks = std::clamp<size_t>(memory_budget / (chunk_size * rowBytes), 2, MAX_WRITE_CHUNKS);
     }
 
-    return {
-        std::move(unionColumns),
-        std::move(unionInfo),
-        totalRecords,
-        valid_files.size(),
+    ChunkReader reader(std::move(setup), chunk_size, skip_first_record, repair);
+    std::vector<std::unique_ptr<NetCDFWriter>> writers(outputs.size());
+    for (size_t k = 0; k < outputs.size(); ++k) {
+        if (columns[k].empty()) continue;
+        std::vector<SensorInfo> info;
+        info.reserve(columns[k].size());
+        for (const size_t i : columns[k]) info.push_back(reader.sensor_info()[i]);
+        writers[k] = std::make_unique<NetCDFWriter>(outputs[k].filename, info, compression);
+    }
+
+    struct Chunk {
+        std::unique_ptr<ColumnArena> columns;
+        size_t n = 0;
     };
+    std::vector<Chunk> chunks(nChunks);
+    recycle_pipeline(chunks,
+        [&](Chunk& c) {
+            if (!c.columns) {
+                c.columns = reader.make_chunk();
+            } else {
+                c.columns->fill(); // Columns a file lacks must read as fill values
+            }
+            c.n = reader.fill(*c.columns);
+            return c.n > 0;
+        },
+        [&](Chunk& c) {
+            for (size_t k = 0; k < writers.size(); ++k) {
+                if (writers[k]) writers[k]->append(*c.columns, columns[k], c.n);
+            }
+        });
+    for (size_t k = 0; k < writers.size(); ++k) {
+        if (!writers[k]) continue;
+        writers[k]->close(reader.n_files());
+        written[k] = {writers[k]->n_records(), reader.n_files()};
+    }
+    return written;
+}
+
+// A multi-file read streamed into one NetCDF-4 file
+std::pair<size_t, size_t> write_netcdf_files(
+    const std::vector<std::string>& filenames,
+    const std::string& output,
+    const std::string& cache_dir,
+    const std::vector<std::string>& to_keep,
+    const std::vector<std::string>& criteria,
+    const std::vector<std::string>& skip_missions,
+    const std::vector<std::string>& keep_missions,
+    bool skip_first_record,
+    bool repair,
+    int compression,
+    size_t chunk_size,
+    size_t n_threads,
+    size_t memory_budget)
+{
+    return write_netcdf_outputs(filenames, {NetCDFOutput{output, to_keep}}, cache_dir, criteria,
+                                skip_missions, keep_missions, skip_first_record, repair,
+                                compression, chunk_size, n_threads, memory_budget)
+        .front();
 }
+#endif // HAVE_NETCDF
 
 SensorListResult scan_sensor_list(
     const std::vector<std::string>& filenames,
     const std::string& cache_dir,
     const std::vector<std::string>& skip_missions,
-    const std::vector<std::string>& keep_missions)
+    const std::vector<std::string>& keep_missions,
+    size_t n_threads = 1)
 {
+    const StageTimer timer(ReadStats::STAGE_SCAN);
     if (filenames.empty()) {
         return {{}, {}, 0};
     }
@@ -353,18 +1687,24 @@ SensorListResult scan_sensor_list(
     SensorsMap smap(cache_dir);
     std::vector<std::string> valid_files;
 
-    for (const auto& fn : sorted_files) {
-        try {
-            DecompressTWR is(fn, qCompressed(fn));
-            if (!is) continue;
-            Header hdr(is, fn.c_str());
-            if (hdr.empty()) continue;
-            if (!hdr.qProcessMission(skipSet, keepSet)) continue;
-            smap.insert(is, hdr, false);
-            valid_files.push_back(fn);
-        } catch (const std::exception&) {
-            continue;
-        }
+    std::vector<uint8_t> qValid(sorted_files.size(), 0);
+    parallel_for(qValid.size(), resolve_threads(n_threads, qValid.size()), [&](size_t i) {
+        const std::string& fn = sorted_files[i];
+        qValid[i] = scan_head(fn, [&](std::istream& is) -> uint8_t {
+            try {
+                if (!is) return 0;
+                Header hdr(is, fn.c_str());
+                if (hdr.empty()) return 0;
+                if (!hdr.qProcessMission(skipSet, keepSet)) return 0;
+                smap.insert(is, hdr, false);
+                return 1;
+            } catch (const std::exception&) {
+                return 0;
+            }
+        });
+    });
+    for (size_t i = 0; i < sorted_files.size(); ++i) {
+        if (qValid[i]) valid_files.push_back(sorted_files[i]);
     }
 
     if (valid_files.empty()) {
@@ -387,8 +1727,10 @@ SensorListResult scan_sensor_list(
 HeaderScanResult scan_file_headers(
     const std::vector<std::string>& filenames,
     const std::vector<std::string>& skip_missions,
-    const std::vector<std::string>& keep_missions)
+    const std::vector<std::string>& keep_missions,
+    size_t n_threads = 1)
 {
+    const StageTimer timer(ReadStats::STAGE_SCAN);
     if (filenames.empty()) {
         return {{}};
     }
@@ -400,24 +1742,30 @@ HeaderScanResult scan_file_headers(
     for (const auto& m : skip_missions) Header::addMission(m, skipSet);
     for (const auto& m : keep_missions) Header::addMission(m, keepSet);
 
-    std::vector<FileHeaderInfo> headers;
+    std::vector<std::optional<FileHeaderInfo>> slots(sorted_files.size());
+    parallel_for(slots.size(), resolve_threads(n_threads, slots.size()), [&](size_t i) {
+        const std::string& fn = sorted_files[i];
+        slots[i] = scan_head(fn, [&](std::istream& is) -> std::optional<FileHeaderInfo> {
+            try {
+                if (!is) return std::nullopt;
+                Header hdr(is, fn.c_str());
+                if (hdr.empty()) return std::nullopt;
+                if (!hdr.qProcessMission(skipSet, keepSet)) return std::nullopt;
+                return FileHeaderInfo{
+                    fn,
+                    std::string(hdr.missionName()),
+                    std::string(hdr.sensorListCRC()),
+                    std::string(hdr.fileopenTime()),
+                };
+            } catch (const std::exception&) {
+                return std::nullopt;
+            }
+        });
+    });
 
-    for (const auto& fn : sorted_files) {
-        try {
-            DecompressTWR is(fn, qCompressed(fn));
-            if (!is) continue;
-            Header hdr(is, fn.c_str());
-            if (hdr.empty()) continue;
-            if (!hdr.qProcessMission(skipSet, keepSet)) continue;
-            headers.push_back({
-                fn,
-                hdr.find("mission_name"),
-                hdr.find("sensor_list_crc"),
-                hdr.find("fileopen_time"),
-            });
-        } catch (const std::exception&) {
-            continue;
-        }
+    std::vector<FileHeaderInfo> headers;
+    for (auto& h : slots) {
+        if (h) headers.push_back(std::move(*h));
     }
 
     return {std::move(headers)};
@@ -425,39 +1773,123 @@ HeaderScanResult scan_file_headers(
 
 // ── Python conversion helpers (called with GIL held) ───────────────────
 
-py::array typed_column_to_numpy(TypedColumn&& col) {
-    return std::visit([](auto&& vec) -> py::array {
-        using VecType = std::decay_t<decltype(vec)>;
-        using T = typename VecType::value_type;
+template <typename T>
+py::array arena_view(const ColumnArena& arena, size_t i, size_t nRows, const py::capsule& owner) {
+    return py::array_t<T>(
+        {static_cast<py::ssize_t>(nRows)},
+        {sizeof(T)},
+        arena.column<T>(i),
+        owner
+    );
+}
 
-        auto heap_vec = std::make_unique<VecType>(std::move(vec));
-        auto* raw = heap_vec.release();
-        auto capsule = py::capsule(raw, [](void* p) {
-            delete static_cast<VecType*>(p);
-        });
+// The first nRows rows of every arena column as numpy arrays: views that
+// share one capsule, which frees the arena along with the last of them
+py::list arena_to_numpy(std::unique_ptr<ColumnArena>&& arena, size_t nRows) {
+    py::list columns;
+    if (!arena) return columns;
+
+    ColumnArena* raw = arena.release();
+    auto owner = py::capsule(raw, [](void* p) {
+        delete static_cast<ColumnArena*>(p);
+    });
+
+    for (size_t i = 0; i < raw->size(); ++i) {
+        switch (raw->kind(i)) {
+            case KIND_INT8: columns.append(arena_view<int8_t>(*raw, i, nRows, owner)); break;
+            case KIND_INT16: columns.append(arena_view<int16_t>(*raw, i, nRows, owner)); break;
+            case KIND_FLOAT32: columns.append(arena_view<float>(*raw, i, nRows, owner)); break;
+            default: columns.append(arena_view<double>(*raw, i, nRows, owner)); break;
+        }
+    }
+    return columns;
+}
+
+// A vector as a numpy array that takes it over
+template <typename T>
+py::array vector_to_numpy(std::vector<T>&& vec) {
+    auto* raw = new std::vector<T>(std::move(vec));
+    auto owner = py::capsule(raw, [](void* p) {
+        delete static_cast<std::vector<T>*>(p);
+    });
+    return py::array_t<T>(
+        {static_cast<py::ssize_t>(raw->size())},
+        {sizeof(T)},
+        raw->data(),
+        owner
+    );
+}
+
+// Sparse columns as lists of run first rows and lengths (int64) and of
+// run values
+void sparse_to_numpy(std::vector<SparseColumn>&& sparse, py::list& rows, py::list& counts,
+                     py::list& values) {
+    for (SparseColumn& col : sparse) {
+        rows.append(vector_to_numpy(std::move(col.rows)));
+        counts.append(vector_to_numpy(std::move(col.counts)));
+        std::visit([&](auto& vec) { values.append(vector_to_numpy(std::move(vec))); }, col.values);
+    }
+    sparse.clear();
+}
+
+template <typename T>
+py::array mapped_view(const char* data, size_t nRows, const py::capsule& owner) {
+    py::array_t<T> view(
+        {static_cast<py::ssize_t>(nRows)},
+        {sizeof(T)},
+        reinterpret_cast<const T*>(data),
+        owner
+    );
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
 
-        return py::array_t<T>(
-            {static_cast<py::ssize_t>(raw->size())},
-            {sizeof(T)},
-            raw->data(),
-            capsule
-        );
-    }, std::move(col));
+// The columns of a read from a column cache file: the named ones as
+// read-only views of the mapped file, sharing one capsule that unmaps it
+// along with the last of them, and the unnamed ones from the arena
+py::list cached_to_numpy(SingleFileResult& r) {
+    const py::list gaps = arena_to_numpy(std::move(r.columns), r.n_records);
+    auto* raw = new ColumnCache::tPtr(std::move(r.cached));
+    auto owner = py::capsule(raw, [](void* p) {
+        delete static_cast<ColumnCache::tPtr*>(p);
+    });
+
+    py::list columns;
+    size_t gap = 0;
+    for (const SensorInfo& si : r.sensor_info) {
+        if (si.name.empty()) {
+            columns.append(gaps[gap++]);
+            continue;
+        }
+        const ColumnCache::Column& col = *(*raw)->find(si.name);
+        const char* data = col.data + r.cachedStart * static_cast<size_t>(col.info.size);
+        switch (column_kind(col.info.size)) {
+            case KIND_INT8: columns.append(mapped_view<int8_t>(data, r.n_records, owner)); break;
+            case KIND_INT16: columns.append(mapped_view<int16_t>(data, r.n_records, owner)); break;
+            case KIND_FLOAT32: columns.append(mapped_view<float>(data, r.n_records, owner)); break;
+            default: columns.append(mapped_view<double>(data, r.n_records, owner)); break;
+        }
+    }
+    return columns;
 }
 
 py::dict single_result_to_python(SingleFileResult&& r) {
+    const StageTimer timer(ReadStats::STAGE_CONVERT);
     py::list columns;
+    py::list rows;
+    py::list counts;
+    if (r.qSparse) {
+        sparse_to_numpy(std::move(r.sparse), rows, counts, columns);
+    } else if (r.cached) {
+        columns = cached_to_numpy(r);
+    } else {
+        columns = arena_to_numpy(std::move(r.columns), r.n_records);
+    }
     py::list sensor_names;
     py::list sensor_units;
     py::list sensor_sizes;
 
-    for (size_t i = 0; i < r.columns.size(); ++i) {
-        if (r.start > 0 && r.n_records > 0) {
-            py::array full_arr = typed_column_to_numpy(std::move(r.columns[i]));
-            columns.append(full_arr[py::slice(py::int_(r.start), py::none(), py::none())]);
-        } else {
-            columns.append(typed_column_to_numpy(std::move(r.columns[i])));
-        }
+    for (size_t i = 0; i < r.sensor_info.size(); ++i) {
         sensor_names.append(r.sensor_info[i].name);
         sensor_units.append(r.sensor_info[i].units);
         sensor_sizes.append(r.sensor_info[i].size);
@@ -474,6 +1906,10 @@ py::dict single_result_to_python(SingleFileResult&& r) {
 
     py::dict out;
     out["columns"] = columns;
+    if (r.qSparse) {
+        out["rows"] = rows;
+        out["counts"] = counts;
+    }
     out["sensor_names"] = sensor_names;
     out["sensor_units"] = sensor_units;
     out["sensor_sizes"] = sensor_sizes;
@@ -484,13 +1920,20 @@ py::dict single_result_to_python(SingleFileResult&& r) {
 }
 
 py::dict multi_result_to_python(MultiFileResult&& r) {
+    const StageTimer timer(ReadStats::STAGE_CONVERT);
     py::list columns;
+    py::list rows;
+    py::list counts;
+    if (r.qSparse) {
+        sparse_to_numpy(std::move(r.sparse), rows, counts, columns);
+    } else {
+        columns = arena_to_numpy(std::move(r.columns), r.n_records);
+    }
     py::list sensor_names;
     py::list sensor_units;
     py::list sensor_sizes;
 
-    for (size_t i = 0; i < r.columns.size(); ++i) {
-        columns.append(typed_column_to_numpy(std::move(r.columns[i])));
+    for (size_t i = 0; i < r.sensor_info.size(); ++i) {
         sensor_names.append(r.sensor_info[i].name);
         sensor_units.append(r.sensor_info[i].units);
         sensor_sizes.append(r.sensor_info[i].size);
@@ -498,6 +1941,10 @@ py::dict multi_result_to_python(MultiFileResult&& r) {
 
     py::dict out;
     out["columns"] = columns;
+    if (r.qSparse) {
+        out["rows"] = rows;
+        out["counts"] = counts;
+    }
     out["sensor_names"] = sensor_names;
     out["sensor_units"] = sensor_units;
     out["sensor_sizes"] = sensor_sizes;
@@ -506,6 +1953,292 @@ py::dict multi_result_to_python(MultiFileResult&& r) {
     return out;
 }
 
+py::dict chunk_to_python(const ChunkReader& r, std::unique_ptr<ColumnArena>&& chunk, size_t n) {
+    const StageTimer timer(ReadStats::STAGE_CONVERT);
+    py::list columns = arena_to_numpy(std::move(chunk), n);
+    py::list sensor_names;
+    py::list sensor_units;
+    py::list sensor_sizes;
+
+    const std::vector<SensorInfo>& info = r.sensor_info();
+    for (size_t i = 0; i < info.size(); ++i) {
+        sensor_names.append(info[i].name);
+        sensor_units.append(info[i].units);
+        sensor_sizes.append(info[i].size);
+    }
+
+    py::dict out;
+    out["columns"] = columns;
+    out["sensor_names"] = sensor_names;
+    out["sensor_units"] = sensor_units;
+    out["sensor_sizes"] = sensor_sizes;
+    out["n_records"] = n;
+    out["n_files"] = r.n_files();
+    return out;
+}
+
+// A sensor of a sync_columns call; arrays that had to be made contiguous
+// (or float64) are appended to keep, to outlive the call
+SyncSource sync_source(const py::handle& time, const py::handle& values, std::vector<py::array>& keep) {
+    using F64 = py::array_t<double, py::array::c_style | py::array::forcecast>;
+    F64 t = F64::ensure(time);
+    py::array v = py::array::ensure(values, py::array::c_style);
+    if (!t || !v || t.ndim() != 1 || v.ndim() != 1) {
+        throw std::invalid_argument("sync_columns takes 1-D time and value arrays");
+    }
+    if (t.shape(0) != v.shape(0)) {
+        throw std::invalid_argument("A value column is not the length of its time column");
+    }
+    const char kind = v.dtype().kind();
+    const bool qNative = (kind == 'i' && (v.itemsize() == 1 || v.itemsize() == 2)) ||
+                         (kind == 'f' && (v.itemsize() == 4 || v.itemsize() == 8));
+    if (!qNative) {
+        v = F64::ensure(v);
+    }
+    SyncSource s;
+    s.time = t.data();
+    s.values = v.data();
+    s.size = static_cast<int>(v.itemsize());
+    s.nRows = static_cast<size_t>(t.shape(0));
+    keep.push_back(std::move(t));
+    keep.push_back(std::move(v));
+    return s;
+}
+
+py::list sensor_field_list(const ChunkReader& r, int field) {
+    py::list out;
+    for (const SensorInfo& si : r.sensor_info()) {
+        switch (field) {
+            case 0: out.append(si.name); break;
+            case 1: out.append(si.units); break;
+            default: out.append(si.size); break;
+        }
+    }
+    return out;
+}
+
+
+// ── Reads submitted to the executor ────────────────────────────────────
+
+// A submit_read call, shared by the executor task reading the file and
+// the DBDReadFuture handed to Python. The mutex is only ever waited for
+// with the GIL released, and the worker never takes the GIL while holding
+// it, so neither waits on the other.
+struct ReadState {
+    enum Status { PENDING, RUNNING, FINISHED, CANCELLED };
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    Status status = PENDING;
+    bool qCollected = false; // result taken to be converted
+    bool qConverted = false; // ... and the conversion over
+    SingleFileResult result;
+    std::exception_ptr error;
+    // (fn, future) pairs to call once done; only touched with the GIL
+    // held, apart from being moved out
+    std::vector<std::pair<py::object, py::object>> callbacks;
+};
+
+std::unique_lock<std::mutex> lock_state(ReadState& s) {
+    py::gil_scoped_release release;
+    return std::unique_lock<std::mutex>(s.mutex);
+}
+
+// Call, and drop, a finished read's callbacks
+void run_callbacks(std::vector<std::pair<py::object, py::object>>& callbacks) {
+    for (auto& cb : callbacks) {
+        try {
+            cb.first(cb.second);
+        } catch (py::error_already_set& e) {
+            e.discard_as_unraisable("DBDReadFuture done callback");
+        }
+    }
+    callbacks.clear();
+}
+
+// Settle s on the worker, which does not hold the GIL
+void finish_read(ReadState& s, SingleFileResult&& result, std::exception_ptr error) {
+    std::vector<std::pair<py::object, py::object>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.result = std::move(result);
+        s.error = error;
+        s.status = ReadState::FINISHED;
+        callbacks.swap(s.callbacks);
+    }
+    s.changed.notify_all();
+    if (!callbacks.empty()) {
+        py::gil_scoped_acquire acquire;
+        run_callbacks(callbacks);
+    }
+}
+
+[[noreturn]] void raise_cancelled() {
+    const py::object cls = py::module_::import("concurrent.futures").attr("CancelledError");
+    PyErr_SetString(cls.ptr(), "The read was cancelled");
+    throw py::error_already_set();
+}
+
+// Python's handle on a submitted read
+class ReadFuture {
+public:
+    ReadFuture(std::shared_ptr<ReadState> state, std::string filename)
+        : mState(std::move(state)), mFilename(std::move(filename)) {}
+
+    const std::string& filename() const { return mFilename; }
+
+    bool done() {
+        auto lock = lock_state(*mState);
+        return mState->status >= ReadState::FINISHED;
+    }
+
+    bool running() {
+        auto lock = lock_state(*mState);
+        return mState->status == ReadState::RUNNING;
+    }
+
+    bool cancelled() {
+        auto lock = lock_state(*mState);
+        return mState->status == ReadState::CANCELLED;
+    }
+
+    // Cancel the read if it has not started; true if it is now cancelled
+    bool cancel() {
+        std::vector<std::pair<py::object, py::object>> callbacks;
+        {
+            auto lock = lock_state(*mState);
+            if (mState->status == ReadState::PENDING) {
+                mState->status = ReadState::CANCELLED;
+                callbacks.swap(mState->callbacks);
+            }
+            if (mState->status != ReadState::CANCELLED) return false;
+        }
+        mState->changed.notify_all();
+        run_callbacks(callbacks);
+        return true;
+    }
+
+    // fn(future) once the read is done or cancelled, on the worker that
+    // read it, or now if that has already happened
+    static void add_done_callback(const py::object& self, const py::object& fn) {
+        ReadFuture& f = self.cast<ReadFuture&>();
+        {
+            auto lock = lock_state(*f.mState);
+            if (f.mState->status < ReadState::FINISHED) {
+                f.mState->callbacks.emplace_back(fn, self);
+                return;
+            }
+        }
+        try {
+            fn(self);
+        } catch (py::error_already_set& e) {
+            e.discard_as_unraisable("DBDReadFuture done callback");
+        }
+    }
+
+    // The read_dbd_file dict, converted to numpy the first time it is
+    // asked for, after waiting up to timeout seconds (None for as long as
+    // it takes) for the read to finish. The converted dict is published,
+    // and read back, under the state's mutex, as result() may be called
+    // from several threads at once without the GIL.
+    py::object result(std::optional<double> timeout) {
+        ReadState& s = *mState;
+        {
+            auto lock = lock_state(s);
+            if (mValue) return mValue;
+        }
+
+        SingleFileResult result;
+        bool qReady = false;
+        ReadState::Status status = ReadState::PENDING;
+        std::exception_ptr error;
+        bool qMine = false; // This call collected the result
+        {
+            py::gil_scoped_release release;
+            std::unique_lock<std::mutex> lock(s.mutex);
+            const auto ready = [&s] {
+                return s.status == ReadState::CANCELLED ||
+                       (s.status == ReadState::FINISHED && (!s.qCollected || s.qConverted));
+            };
+            if (!timeout) {
+                s.changed.wait(lock, ready);
+                qReady = true;
+            } else {
+                const std::chrono::duration<double> wait(std::max(0.0, *timeout));
+                qReady = s.changed.wait_for(lock, wait, ready);
+            }
+            status = s.status;
+            error = s.error;
+            if (qReady && status == ReadState::FINISHED && !error && !s.qCollected) {
+                result = std::move(s.result);
+                s.qCollected = qMine = true;
+            }
+        }
+
+        // Still reading, or another thread still converting the result
+        if (!qReady) {
+            PyErr_SetString(PyExc_TimeoutError, ("Reading " + mFilename + " did not finish in time").c_str());
+            throw py::error_already_set();
+        }
+        if (status == ReadState::CANCELLED) raise_cancelled();
+        if (error) std::rethrow_exception(error);
+        if (!qMine) { // Another thread converted it while this one waited
+            auto lock = lock_state(s);
+            if (mValue) return mValue;
+            throw std::runtime_error("Converting " + mFilename + " failed");
+        }
+
+        py::object value;
+        try {
+            value = single_result_to_python(std::move(result));
+        } catch (...) {
+            {
+                auto lock = lock_state(s);
+                s.qConverted = true;
+            }
+            s.changed.notify_all();
+            throw;
+        }
+        {
+            auto lock = lock_state(s);
+            mValue = value;
+            s.qConverted = true;
+        }
+        s.changed.notify_all();
+        return value;
+    }
+private:
+    std::shared_ptr<ReadState> mState;
+    std::string mFilename;
+    py::object mValue; // The converted result, once collected; under mState->mutex
+};
+
+// The process-wide executor submit_read queues reads on, started on first
+// use with gExecutorThreads workers
+std::mutex gExecutorMutex;
+std::unique_ptr<Executor> gExecutor;
+size_t gExecutorThreads = 0;
+
+void submit_task(Executor::tTask task) {
+    std::lock_guard<std::mutex> lock(gExecutorMutex);
+    if (!gExecutor) {
+        gExecutor = std::make_unique<Executor>(gExecutorThreads);
+    }
+    gExecutor->submit(std::move(task));
+}
+
+// Replace the executor, letting the old one finish what it has queued
+void reset_executor(size_t nThreads) {
+    std::unique_ptr<Executor> old;
+    {
+        std::lock_guard<std::mutex> lock(gExecutorMutex);
+        old = std::move(gExecutor);
+        gExecutorThreads = nThreads;
+    }
+    py::gil_scoped_release release; // Its reads' callbacks need the GIL
+    old.reset();
+}
+
 } // anonymous namespace
 
 
@@ -513,22 +2246,336 @@ py::dict multi_result_to_python(MultiFileResult&& r) {
 PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
     m.doc() = "C++ backend for reading Dinkum Binary Data (DBD) files";
 
-    m.def("read_dbd_file",
-        [](const std::string& filename,
+    m.def("read_dbd_file",
+        [](const std::string& filename,
+           const std::string& cache_dir,
+           const std::vector<std::string>& to_keep,
+           const std::vector<std::string>& criteria,
+           bool skip_first_record,
+           bool repair,
+           std::optional<double> time_start,
+           std::optional<double> time_end,
+           const std::string& time_sensor,
+           const ValueRanges& ranges,
+           bool sparse,
+           bool column_cache) -> py::dict {
+            const TimeWindow window{time_start, time_end, time_sensor};
+            // Parse entirely in C++ with GIL released
+            SingleFileResult result;
+            {
+                py::gil_scoped_release release;
+                result = parse_single_file(filename, cache_dir, to_keep,
+                                           criteria, skip_first_record, repair,
+                                           window, ranges, sparse, column_cache);
+            }
+            // GIL reacquired — convert to Python objects
+            return single_result_to_python(std::move(result));
+        },
+        py::arg("filename"),
+        py::arg("cache_dir") = "",
+        py::arg("to_keep") = std::vector<std::string>(),
+        py::arg("criteria") = std::vector<std::string>(),
+        py::arg("skip_first_record") = true,
+        py::arg("repair") = false,
+        py::arg("time_start") = py::none(),
+        py::arg("time_end") = py::none(),
+        py::arg("time_sensor") = "",
+        py::arg("ranges") = ValueRanges(),
+        py::arg("sparse") = false,
+        py::arg("column_cache") = false,
+        "Read a single DBD file and return column-oriented data.\n\n"
+        "Parameters\n"
+        "----------\n"
+        "filename : str\n"
+        "    Path to the DBD file (.dbd, .ebd, .sbd, .tbd, .mbd, .nbd,\n"
+        "    or their compressed .?cd variants).\n"
+        "cache_dir : str, optional\n"
+        "    Directory containing sensor cache files (.cac/.ccc).\n"
+        "    Defaults to empty string (no cache).\n"
+        "to_keep : list of str, optional\n"
+        "    Sensor names to retain. Empty list means keep all.\n"
+        "criteria : list of str, optional\n"
+        "    Sensor names used for record selection criteria.\n"
+        "skip_first_record : bool, optional\n"
+        "    If True (default), drop the first data record.\n"
+        "repair : bool, optional\n"
+        "    If True, attempt to recover data from corrupted records.\n"
+        "time_start, time_end : float, optional\n"
+        "    Keep only the records whose time_sensor value lies in\n"
+        "    [time_start, time_end]; either end may be left open. Records\n"
+        "    are tested as they are decoded, and those outside are never\n"
+        "    stored. Records without a time are dropped.\n"
+        "time_sensor : str, optional\n"
+        "    Sensor the window applies to. Empty (default) means\n"
+        "    m_present_time, or sci_m_present_time if the file lacks it.\n"
+        "ranges : dict of str to (float or None, float or None), optional\n"
+        "    Further inclusive ranges of sensor values a record must meet,\n"
+        "    tested like the time window. Sensors selected on, including\n"
+        "    the time sensor, are always returned.\n"
+        "sparse : bool, optional\n"
+        "    If True, return each column as runs of rows holding one value,\n"
+        "    taken from the records' state codes (a new value starts a run\n"
+        "    and repeats after it extend it), instead of n_records values\n"
+        "    mostly holding the fill value. Use xarray_dbd.densify to expand\n"
+        "    the result.\n"
+        "column_cache : bool, optional\n"
+        "    If True, keep the file decoded in a column cache file in the\n"
+        "    columns subdirectory of cache_dir, which is then required, and\n"
+        "    read it from there while the file, its sensor list and repair\n"
+        "    are unchanged. The sensors' columns are then read-only views of\n"
+        "    the mapped cache file. Reads with criteria, a time window,\n"
+        "    ranges or sparse, and files whose values cannot all be stored,\n"
+        "    are decoded as usual.\n\n"
+        "Returns\n"
+        "-------\n"
+        "dict\n"
+        "    columns : list of numpy arrays (int8/int16/float32/float64),\n"
+        "        if sparse of the value of each run\n"
+        "    rows, counts : list of int64 numpy arrays, only if sparse; the\n"
+        "        first row and number of rows of each run\n"
+        "    sensor_names : list of str\n"
+        "    sensor_units : list of str\n"
+        "    sensor_sizes : list of int (1, 2, 4, or 8)\n"
+        "    n_records : int\n"
+        "    header : dict of str to str\n"
+        "    filename : str"
+    );
+
+    m.def("read_dbd_files",
+        [](const std::vector<std::string>& filenames,
+           const std::string& cache_dir,
+           const std::vector<std::string>& to_keep,
+           const std::vector<std::string>& criteria,
+           const std::vector<std::string>& skip_missions,
+           const std::vector<std::string>& keep_missions,
+           bool skip_first_record,
+           bool repair,
+           size_t n_threads,
+           std::optional<double> time_start,
+           std::optional<double> time_end,
+           const std::string& time_sensor,
+           const ValueRanges& ranges,
+           bool sparse,
+           bool column_cache) -> py::dict {
+            const TimeWindow window{time_start, time_end, time_sensor};
+            MultiFileResult result;
+            {
+                py::gil_scoped_release release;
+                result = parse_multiple_files(filenames, cache_dir, to_keep,
+                                              criteria, skip_missions,
+                                              keep_missions, skip_first_record,
+                                              repair, n_threads, window, ranges,
+                                              sparse, column_cache);
+            }
+            return multi_result_to_python(std::move(result));
+        },
+        py::arg("filenames"),
+        py::arg("cache_dir") = "",
+        py::arg("to_keep") = std::vector<std::string>(),
+        py::arg("criteria") = std::vector<std::string>(),
+        py::arg("skip_missions") = std::vector<std::string>(),
+        py::arg("keep_missions") = std::vector<std::string>(),
+        py::arg("skip_first_record") = true,
+        py::arg("repair") = false,
+        py::arg("n_threads") = 1,
+        py::arg("time_start") = py::none(),
+        py::arg("time_end") = py::none(),
+        py::arg("time_sensor") = "",
+        py::arg("ranges") = ValueRanges(),
+        py::arg("sparse") = false,
+        py::arg("column_cache") = false,
+        "Read multiple DBD files with sensor union and return concatenated data.\n\n"
+        "Uses a two-pass approach: pass 1 scans headers and builds a unified\n"
+        "sensor list via SensorsMap, pass 2 reads data and merges into union\n"
+        "columns. Files are sorted internally.\n\n"
+        "Parameters\n"
+        "----------\n"
+        "filenames : list of str\n"
+        "    Paths to DBD files.\n"
+        "cache_dir : str, optional\n"
+        "    Directory containing sensor cache files (.cac/.ccc).\n"
+        "to_keep : list of str, optional\n"
+        "    Sensor names to retain. Empty list means keep all.\n"
+        "criteria : list of str, optional\n"
+        "    Sensor names used for record selection criteria.\n"
+        "skip_missions : list of str, optional\n"
+        "    Mission names to exclude.\n"
+        "keep_missions : list of str, optional\n"
+        "    Mission names to include (excludes all others).\n"
+        "skip_first_record : bool, optional\n"
+        "    If True (default), drop the first record of each file after\n"
+        "    the first.\n"
+        "repair : bool, optional\n"
+        "    If True, attempt to recover data from corrupted records.\n"
+        "n_threads : int, optional\n"
+        "    Number of threads used to scan headers in pass 1 and decode files\n"
+        "    in pass 2. 1 (default) runs serially, 0 uses all hardware\n"
+        "    threads. Output is identical for any thread count.\n"
+        "time_start, time_end : float, optional\n"
+        "    Keep only the records whose time_sensor value lies in\n"
+        "    [time_start, time_end]; either end may be left open. Records\n"
+        "    are tested as they are decoded, and those outside are never\n"
+        "    stored. Records without a time are dropped. With a cache_dir,\n"
+        "    a record index of each file's time range is kept in its index\n"
+        "    subdirectory, and files wholly outside the window are not read.\n"
+        "time_sensor : str, optional\n"
+        "    Sensor the window applies to. Empty (default) means\n"
+        "    m_present_time, or sci_m_present_time if no file has it.\n"
+        "ranges : dict of str to (float or None, float or None), optional\n"
+        "    Further inclusive ranges of sensor values a record must meet,\n"
+        "    tested like the time window. Sensors selected on, including\n"
+        "    the time sensor, are always returned.\n"
+        "sparse : bool, optional\n"
+        "    If True, return each column as runs of rows holding one value,\n"
+        "    taken from the records' state codes (a new value starts a run\n"
+        "    and repeats after it extend it), instead of n_records values\n"
+        "    mostly holding the fill value. Use xarray_dbd.densify to expand\n"
+        "    the result. Files are decoded without a record pre-scan, and\n"
+        "    time windows are applied after decoding, without the record\n"
+        "    index.\n"
+        "column_cache : bool, optional\n"
+        "    If True, keep each file decoded in a column cache file in the\n"
+        "    columns subdirectory of cache_dir, which is then required, and\n"
+        "    copy its rows from there, without loading or decoding the file,\n"
+        "    while the file, its sensor list and repair are unchanged. Reads\n"
+        "    with criteria, a time window, ranges or sparse, and files whose\n"
+        "    values cannot all be stored, are decoded as usual.\n\n"
+        "Returns\n"
+        "-------\n"
+        "dict\n"
+        "    columns : list of numpy arrays (int8/int16/float32/float64),\n"
+        "        if sparse of the value of each run\n"
+        "    rows, counts : list of int64 numpy arrays, only if sparse; the\n"
+        "        first row and number of rows of each run\n"
+        "    sensor_names : list of str\n"
+        "    sensor_units : list of str\n"
+        "    sensor_sizes : list of int (1, 2, 4, or 8)\n"
+        "    n_records : int\n"
+        "    n_files : int"
+    );
+
+    py::class_<ChunkReader>(m, "DBDChunkIterator",
+        "Iterator over fixed-size record chunks of a multi-file read.\n\n"
+        "Created by read_dbd_files_iter. Each item is a dict shaped like the\n"
+        "result of read_dbd_files, holding the next n_records (at most\n"
+        "chunk_size) rows of the union columns.")
+        .def("__iter__", [](ChunkReader& r) -> ChunkReader& { return r; })
+        .def("__next__", [](ChunkReader& r) -> py::dict {
+            std::unique_ptr<ColumnArena> chunk;
+            size_t n = 0;
+            {
+                py::gil_scoped_release release;
+                std::lock_guard<std::mutex> lock(r.mutex());
+                chunk = r.make_chunk();
+                n = r.fill(*chunk);
+            }
+            if (n == 0) {
+                throw py::stop_iteration();
+            }
+            return chunk_to_python(r, std::move(chunk), n);
+        })
+        .def_property_readonly("sensor_names",
+            [](const ChunkReader& r) { return sensor_field_list(r, 0); })
+        .def_property_readonly("sensor_units",
+            [](const ChunkReader& r) { return sensor_field_list(r, 1); })
+        .def_property_readonly("sensor_sizes",
+            [](const ChunkReader& r) { return sensor_field_list(r, 2); })
+        .def_property_readonly("n_files", &ChunkReader::n_files)
+        .def_property_readonly("chunk_size", &ChunkReader::chunk_size);
+
+    m.def("read_dbd_files_iter",
+        [](const std::vector<std::string>& filenames,
            const std::string& cache_dir,
            const std::vector<std::string>& to_keep,
            const std::vector<std::string>& criteria,
+           const std::vector<std::string>& skip_missions,
+           const std::vector<std::string>& keep_missions,
            bool skip_first_record,
-           bool repair) -> py::dict {
-            // Parse entirely in C++ with GIL released
+           bool repair,
+           size_t chunk_size) -> std::unique_ptr<ChunkReader> {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("chunk_size must be positive");
+            }
+            py::gil_scoped_release release;
+            return std::make_unique<ChunkReader>(
+                setup_multiple_files(filenames, cache_dir, to_keep, criteria,
+                                     skip_missions, keep_missions),
+                chunk_size, skip_first_record, repair);
+        },
+        py::arg("filenames"),
+        py::arg("cache_dir") = "",
+        py::arg("to_keep") = std::vector<std::string>(),
+        py::arg("criteria") = std::vector<std::string>(),
+        py::arg("skip_missions") = std::vector<std::string>(),
+        py::arg("keep_missions") = std::vector<std::string>(),
+        py::arg("skip_first_record") = true,
+        py::arg("repair") = false,
+        py::arg("chunk_size") = 65536,
+        "Stream multiple DBD files as fixed-size chunks of union columns.\n\n"
+        "Headers are scanned up front as in read_dbd_files; data is then\n"
+        "decoded one file at a time into pooled chunk buffers, so memory\n"
+        "stays bounded by one file plus the chunks still referenced,\n"
+        "however many files are read. Concatenating the chunks gives the\n"
+        "read_dbd_files result.\n\n"
+        "Parameters\n"
+        "----------\n"
+        "filenames : list of str\n"
+        "    Paths to DBD files.\n"
+        "cache_dir : str, optional\n"
+        "    Directory containing sensor cache files (.cac/.ccc).\n"
+        "to_keep : list of str, optional\n"
+        "    Sensor names to retain. Empty list means keep all.\n"
+        "criteria : list of str, optional\n"
+        "    Sensor names used for record selection criteria.\n"
+        "skip_missions : list of str, optional\n"
+        "    Mission names to exclude.\n"
+        "keep_missions : list of str, optional\n"
+        "    Mission names to include (excludes all others).\n"
+        "skip_first_record : bool, optional\n"
+        "    If True (default), drop the first record of each file after\n"
+        "    the first.\n"
+        "repair : bool, optional\n"
+        "    If True, attempt to recover data from corrupted records.\n"
+        "chunk_size : int, optional\n"
+        "    Maximum records per chunk (default 65536).\n\n"
+        "Returns\n"
+        "-------\n"
+        "DBDChunkIterator\n"
+        "    Yields dicts with the same keys as read_dbd_files; only the\n"
+        "    last chunk may be shorter than chunk_size. sensor_names,\n"
+        "    sensor_units, sensor_sizes and n_files are also attributes."
+    );
+
+    py::class_<AppendReader>(m, "DBDAppendReader",
+        "Incremental reader of one DBD file that is still being written.\n\n"
+        "Created by open_dbd_append. Each read() returns a dict shaped like\n"
+        "the result of read_dbd_file, holding only the records completed\n"
+        "since the previous read.")
+        .def("read", [](AppendReader& r) -> py::dict {
             SingleFileResult result;
             {
                 py::gil_scoped_release release;
-                result = parse_single_file(filename, cache_dir, to_keep,
-                                           criteria, skip_first_record, repair);
+                std::lock_guard<std::mutex> lock(r.mutex());
+                result = r.read();
             }
-            // GIL reacquired — convert to Python objects
             return single_result_to_python(std::move(result));
+        }, "Decode the records appended since the last read.")
+        .def_property_readonly("filename", &AppendReader::filename)
+        .def_property_readonly("n_records", &AppendReader::n_records,
+            "Records returned by all reads so far.")
+        .def_property_readonly("offset", &AppendReader::offset,
+            "Offset in the (decompressed) file of the next unread record.");
+
+    m.def("open_dbd_append",
+        [](const std::string& filename,
+           const std::string& cache_dir,
+           const std::vector<std::string>& to_keep,
+           const std::vector<std::string>& criteria,
+           bool skip_first_record,
+           bool repair) -> std::unique_ptr<AppendReader> {
+            py::gil_scoped_release release;
+            return std::make_unique<AppendReader>(filename, cache_dir, to_keep,
+                                                  criteria, skip_first_record, repair);
         },
         py::arg("filename"),
         py::arg("cache_dir") = "",
@@ -536,15 +2583,21 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         py::arg("criteria") = std::vector<std::string>(),
         py::arg("skip_first_record") = true,
         py::arg("repair") = false,
-        "Read a single DBD file and return column-oriented data.\n\n"
+        "Open a DBD file that is still growing for incremental reads.\n\n"
+        "The header and sensor list are parsed once, here. Each read() of\n"
+        "the returned reader then decodes only the bytes appended since the\n"
+        "last one, carrying the repeat values over, so polling a live file\n"
+        "costs time in proportion to its new data. Concatenating the reads\n"
+        "gives the read_dbd_file result for the file as it stands, except\n"
+        "that a record cut short at the end is held back until it is\n"
+        "complete.\n\n"
         "Parameters\n"
         "----------\n"
         "filename : str\n"
-        "    Path to the DBD file (.dbd, .ebd, .sbd, .tbd, .mbd, .nbd,\n"
-        "    or their compressed .?cd variants).\n"
+        "    Path to the DBD file; its header, sensor list and known bytes\n"
+        "    must already be written.\n"
         "cache_dir : str, optional\n"
         "    Directory containing sensor cache files (.cac/.ccc).\n"
-        "    Defaults to empty string (no cache).\n"
         "to_keep : list of str, optional\n"
         "    Sensor names to retain. Empty list means keep all.\n"
         "criteria : list of str, optional\n"
@@ -555,36 +2608,307 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         "    If True, attempt to recover data from corrupted records.\n\n"
         "Returns\n"
         "-------\n"
-        "dict\n"
-        "    columns : list of numpy arrays (int8/int16/float32/float64)\n"
-        "    sensor_names : list of str\n"
-        "    sensor_units : list of str\n"
-        "    sensor_sizes : list of int (1, 2, 4, or 8)\n"
-        "    n_records : int\n"
-        "    header : dict of str to str\n"
-        "    filename : str"
+        "DBDAppendReader\n"
+        "    read() returns dicts with the same keys as read_dbd_file;\n"
+        "    n_records and offset track progress through the file."
     );
 
-    m.def("read_dbd_files",
+    py::class_<IndexedReader>(m, "DBDFileHandle",
+        "One DBD file held open and indexed for column-at-a-time reads.\n\n"
+        "Created by open_dbd_file. Each read(to_keep) returns a dict shaped\n"
+        "like the result of read_dbd_file for the same to_keep.")
+        .def("read", [](const IndexedReader& r, const std::vector<std::string>& to_keep) -> py::dict {
+            SingleFileResult result;
+            {
+                py::gil_scoped_release release;
+                result = r.read(to_keep);
+            }
+            return single_result_to_python(std::move(result));
+        },
+        py::arg("to_keep") = std::vector<std::string>(),
+        "Read the columns of the sensors in to_keep (all if empty).")
+        .def_property_readonly("filename", &IndexedReader::filename)
+        .def_property_readonly("n_records", &IndexedReader::n_records,
+            "Records each read returns.");
+
+    m.def("open_dbd_file",
+        [](const std::string& filename,
+           const std::string& cache_dir,
+           const std::vector<std::string>& criteria,
+           bool skip_first_record,
+           bool repair) -> std::unique_ptr<IndexedReader> {
+            py::gil_scoped_release release;
+            return std::make_unique<IndexedReader>(filename, cache_dir, criteria,
+                                                   skip_first_record, repair);
+        },
+        py::arg("filename"),
+        py::arg("cache_dir") = "",
+        py::arg("criteria") = std::vector<std::string>(),
+        py::arg("skip_first_record") = true,
+        py::arg("repair") = false,
+        "Open a DBD file for repeated reads of a few sensors at a time.\n\n"
+        "The file is loaded (and decompressed) and its header and sensor\n"
+        "list parsed once, here, and one pass over its records notes where\n"
+        "every sensor's values lie. Each read(to_keep) of the returned\n"
+        "handle then loads just those sensors' values, without walking the\n"
+        "records again, so asking for one more variable costs time in\n"
+        "proportion to its values rather than to the file. The file's\n"
+        "contents stay in memory (or mapped) until the handle is released.\n\n"
+        "Parameters\n"
+        "----------\n"
+        "filename : str\n"
+        "    Path to the DBD file.\n"
+        "cache_dir : str, optional\n"
+        "    Directory containing sensor cache files (.cac/.ccc).\n"
+        "criteria : list of str, optional\n"
+        "    Sensor names used for record selection criteria.\n"
+        "skip_first_record : bool, optional\n"
+        "    If True (default), drop the first data record.\n"
+        "repair : bool, optional\n"
+        "    If True, attempt to recover data from corrupted records.\n\n"
+        "Returns\n"
+        "-------\n"
+        "DBDFileHandle\n"
+        "    read(to_keep) returns dicts with the same keys as\n"
+        "    read_dbd_file; n_records is the number of rows in each."
+    );
+
+    py::class_<ReadFuture>(m, "DBDReadFuture",
+        "A read started by submit_read, running or queued on the executor.\n\n"
+        "Shaped like concurrent.futures.Future, and awaitable from a running\n"
+        "asyncio event loop, which gives the result dict.")
+        .def("done", &ReadFuture::done,
+            "True once the read has finished or been cancelled.")
+        .def("running", &ReadFuture::running,
+            "True while a worker is reading the file.")
+        .def("cancelled", &ReadFuture::cancelled,
+            "True if the read was cancelled before it started.")
+        .def("cancel", &ReadFuture::cancel,
+            "Cancel the read if it has not started; True if it is cancelled.")
+        .def("result", &ReadFuture::result,
+            py::arg("timeout") = py::none(),
+            "Wait up to timeout seconds (None for as long as it takes) for the\n"
+            "read and return its read_dbd_file dict. The columns are handed to\n"
+            "numpy by the first call; later calls return the same dict. Raises\n"
+            "what the read raised, TimeoutError if it is still running, and\n"
+            "concurrent.futures.CancelledError if it was cancelled.")
+        .def("add_done_callback", &ReadFuture::add_done_callback,
+            py::arg("fn"),
+            "Call fn(future) once the read is done, on the executor thread that\n"
+            "read it, or at once if it is already done. Exceptions fn raises\n"
+            "are reported through sys.unraisablehook.")
+        .def("__await__", [](const py::object& self) {
+            // Settle an asyncio future of the running loop from the worker
+            // through call_soon_threadsafe, so the result is converted on
+            // the loop's thread, and cancel the read if the awaiter goes
+            const py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+            const py::object waiter = loop.attr("create_future")();
+            const py::cpp_function settle([self, waiter]() {
+                if (waiter.attr("done")().cast<bool>()) return;
+                try {
+                    waiter.attr("set_result")(self.attr("result")());
+                } catch (py::error_already_set& e) {
+                    waiter.attr("set_exception")(e.value());
+                }
+            });
+            waiter.attr("add_done_callback")(py::cpp_function([self](const py::object& w) {
+                if (w.attr("cancelled")().cast<bool>()) self.attr("cancel")();
+            }));
+            ReadFuture::add_done_callback(self, py::cpp_function([loop, settle](const py::object&) {
+                loop.attr("call_soon_threadsafe")(settle);
+            }));
+            return waiter.attr("__await__")();
+        })
+        .def_property_readonly("filename", &ReadFuture::filename);
+
+    m.def("submit_read",
+        [](const std::string& filename,
+           const std::string& cache_dir,
+           const std::vector<std::string>& to_keep,
+           const std::vector<std::string>& criteria,
+           bool skip_first_record,
+           bool repair,
+           std::optional<double> time_start,
+           std::optional<double> time_end,
+           const std::string& time_sensor,
+           const ValueRanges& ranges,
+           bool sparse,
+           bool column_cache) -> ReadFuture {
+            const TimeWindow window{time_start, time_end, time_sensor};
+            auto state = std::make_shared<ReadState>();
+            Executor::tTask task = [state, filename, cache_dir, to_keep, criteria,
+                                    skip_first_record, repair, window, ranges,
+                                    sparse, column_cache]() {
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (state->status != ReadState::PENDING) return; // Cancelled
+                    state->status = ReadState::RUNNING;
+                }
+                SingleFileResult result;
+                std::exception_ptr error;
+                try {
+                    result = parse_single_file(filename, cache_dir, to_keep,
+                                               criteria, skip_first_record, repair,
+                                               window, ranges, sparse, column_cache);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                finish_read(*state, std::move(result), error);
+            };
+            {
+                py::gil_scoped_release release;
+                submit_task(std::move(task));
+            }
+            return ReadFuture(std::move(state), filename);
+        },
+        py::arg("filename"),
+        py::arg("cache_dir") = "",
+        py::arg("to_keep") = std::vector<std::string>(),
+        py::arg("criteria") = std::vector<std::string>(),
+        py::arg("skip_first_record") = true,
+        py::arg("repair") = false,
+        py::arg("time_start") = py::none(),
+        py::arg("time_end") = py::none(),
+        py::arg("time_sensor") = "",
+        py::arg("ranges") = ValueRanges(),
+        py::arg("sparse") = false,
+        py::arg("column_cache") = false,
+        "Start reading a DBD file on the executor and return at once.\n\n"
+        "Takes the arguments of read_dbd_file. The file is read on one of a\n"
+        "fixed pool of native worker threads shared by every submit_read call\n"
+        "(see set_executor_threads), without the GIL and without a Python\n"
+        "thread of its own, so many reads can be in flight at once. Idle\n"
+        "workers take queued reads from busy ones. The decoded columns are\n"
+        "kept in C++ until the result is collected.\n\n"
+        "Returns\n"
+        "-------\n"
+        "DBDReadFuture\n"
+        "    result() returns the dict read_dbd_file would have, and\n"
+        "    ``await`` gives it in a coroutine."
+    );
+
+    m.def("set_executor_threads",
+        [](size_t n_threads) { reset_executor(n_threads); },
+        py::arg("n_threads") = 0,
+        "Set the number of worker threads submit_read uses (0, the default,\n"
+        "for all hardware threads).\n\n"
+        "Waits for the reads already submitted, which finish on the old\n"
+        "workers; the new pool starts with the next submit_read."
+    );
+
+    // Finish the executor's reads while the interpreter can still run
+    // their callbacks
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() { reset_executor(0); }));
+
+    m.def("sync_columns",
+        [](const py::array_t<double, py::array::c_style | py::array::forcecast>& t,
+           const std::vector<py::object>& times,
+           const std::vector<py::object>& values,
+           const std::vector<double>& limits,
+           const std::vector<bool>& decimal,
+           size_t n_threads) -> py::tuple {
+            if (t.ndim() != 1) {
+                throw std::invalid_argument("t must be 1-D");
+            }
+            if (times.size() != values.size()) {
+                throw std::invalid_argument("times and values must be the same length");
+            }
+            if ((!limits.empty() && limits.size() != values.size()) ||
+                (!decimal.empty() && decimal.size() != values.size())) {
+                throw std::invalid_argument("limits and decimal must be empty or one per column");
+            }
+            std::vector<py::array> keep;
+            std::vector<SyncSource> sources;
+            for (size_t k = 0; k < values.size(); ++k) {
+                sources.push_back(sync_source(times[k], values[k], keep));
+                if (!limits.empty()) sources.back().limit = limits[k];
+                if (!decimal.empty()) sources.back().qDecimal = decimal[k];
+            }
+
+            const size_t nRef = static_cast<size_t>(t.shape(0));
+            py::list columns;
+            std::vector<double*> out;
+            for (size_t k = 0; k < sources.size(); ++k) {
+                py::array_t<double> col(static_cast<py::ssize_t>(nRef));
+                out.push_back(col.mutable_data());
+                columns.append(col);
+            }
+            std::vector<size_t> nValid;
+            {
+                py::gil_scoped_release release;
+                nValid = sync_columns(t.data(), nRef, sources, out.data(), n_threads);
+            }
+            return py::make_tuple(columns, nValid);
+        },
+        py::arg("t"),
+        py::arg("times"),
+        py::arg("values"),
+        py::arg("limits") = std::vector<double>(),
+        py::arg("decimal") = std::vector<bool>(),
+        py::arg("n_threads") = 0,
+        "Interpolate sensor columns onto a common time base.\n\n"
+        "For each pair of times[k] and values[k], such as a time sensor and\n"
+        "another sensor's column from the same read, the rows with a finite\n"
+        "time and a value that is not NaN or an integer fill value are\n"
+        "taken (less those beyond limits[k] in magnitude, and converted from\n"
+        "NMEA ddmm.mm to decimal degrees if decimal[k]) and interpolated\n"
+        "onto t as numpy.interp(t, time, value, left=nan, right=nan) would.\n"
+        "No per-sensor arrays are built in Python, and the columns are\n"
+        "spread over threads with the GIL released.\n\n"
+        "Parameters\n"
+        "----------\n"
+        "t : numpy.ndarray\n"
+        "    Time base, converted to float64.\n"
+        "times : list of numpy.ndarray\n"
+        "    Time column for each value column, converted to float64.\n"
+        "values : list of numpy.ndarray\n"
+        "    Value columns; int8, int16, float32 and float64 are read as\n"
+        "    they are, anything else converted to float64.\n"
+        "limits : list of float, optional\n"
+        "    Largest magnitude kept per column (default: no limit).\n"
+        "decimal : list of bool, optional\n"
+        "    Convert a column from NMEA format (default: no).\n"
+        "n_threads : int, optional\n"
+        "    Worker threads; 0 (default) for one per core, at most one per\n"
+        "    column.\n\n"
+        "Returns\n"
+        "-------\n"
+        "tuple of (list of numpy.ndarray, list of int)\n"
+        "    The float64 columns on t, and the number of rows of each value\n"
+        "    column used; a column with none is all NaN."
+    );
+
+#ifdef HAVE_NETCDF
+    m.attr("has_netcdf_writer") = true;
+
+    m.def("write_dbd_netcdf",
         [](const std::vector<std::string>& filenames,
+           const std::string& output,
            const std::string& cache_dir,
            const std::vector<std::string>& to_keep,
            const std::vector<std::string>& criteria,
            const std::vector<std::string>& skip_missions,
            const std::vector<std::string>& keep_missions,
            bool skip_first_record,
-           bool repair) -> py::dict {
-            MultiFileResult result;
-            {
-                py::gil_scoped_release release;
-                result = parse_multiple_files(filenames, cache_dir, to_keep,
-                                              criteria, skip_missions,
-                                              keep_missions, skip_first_record,
-                                              repair);
+           bool repair,
+           int compression,
+           size_t chunk_size,
+           size_t n_threads,
+           size_t memory_budget) -> std::pair<size_t, size_t> {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("chunk_size must be positive");
             }
-            return multi_result_to_python(std::move(result));
+            if (compression < 0 || compression > 9) {
+                throw std::invalid_argument("compression must be 0-9");
+            }
+            py::gil_scoped_release release;
+            return write_netcdf_files(filenames, output, cache_dir, to_keep, criteria,
+                                      skip_missions, keep_missions, skip_first_record,
+                                      repair, compression, chunk_size, n_threads,
+                                      memory_budget);
         },
         py::arg("filenames"),
+        py::arg("output"),
         py::arg("cache_dir") = "",
         py::arg("to_keep") = std::vector<std::string>(),
         py::arg("criteria") = std::vector<std::string>(),
@@ -592,14 +2916,22 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         py::arg("keep_missions") = std::vector<std::string>(),
         py::arg("skip_first_record") = true,
         py::arg("repair") = false,
-        "Read multiple DBD files with sensor union and return concatenated data.\n\n"
-        "Uses a two-pass approach: pass 1 scans headers and builds a unified\n"
-        "sensor list via SensorsMap, pass 2 reads data and merges into union\n"
-        "columns. Files are sorted internally.\n\n"
+        py::arg("compression") = 5,
+        py::arg("chunk_size") = 65536,
+        py::arg("n_threads") = 1,
+        py::arg("memory_budget") = DEFAULT_WRITE_BUDGET,
+        "Stream multiple DBD files into a NetCDF-4 file without Python objects.\n\n"
+        "Decodes as read_dbd_files_iter does, a chunk of union columns at a\n"
+        "time, on a thread of its own, and writes each chunk through\n"
+        "netCDF-C while the next ones are decoded, with the GIL released\n"
+        "throughout. The file has the layout write_multi_dbd_netcdf writes.\n"
+        "Only present when built with the XDBD_NETCDF_WRITER CMake option.\n\n"
         "Parameters\n"
         "----------\n"
         "filenames : list of str\n"
         "    Paths to DBD files.\n"
+        "output : str\n"
+        "    NetCDF file to create; an existing file is overwritten.\n"
         "cache_dir : str, optional\n"
         "    Directory containing sensor cache files (.cac/.ccc).\n"
         "to_keep : list of str, optional\n"
@@ -611,31 +2943,124 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         "keep_missions : list of str, optional\n"
         "    Mission names to include (excludes all others).\n"
         "skip_first_record : bool, optional\n"
-        "    If True (default), drop the first record of each file after\n"
-        "    the first.\n"
+        "    If True (default), skip first record of each file except the first.\n"
         "repair : bool, optional\n"
-        "    If True, attempt to recover data from corrupted records.\n\n"
+        "    If True, attempt to recover data from corrupted records.\n"
+        "compression : int, optional\n"
+        "    Zlib level 0-9 (default 5, 0 disables compression).\n"
+        "chunk_size : int, optional\n"
+        "    Most records decoded and written at a time (default 65536).\n"
+        "n_threads : int, optional\n"
+        "    Number of threads scanning headers. 1 (default) runs serially,\n"
+        "    0 uses all hardware threads.\n"
+        "memory_budget : int, optional\n"
+        "    Bytes of decoded chunks held between decoding and writing\n"
+        "    (default 256 MiB): as many chunks as fit, 2 to 8, with chunks\n"
+        "    shortened if two do not fit. 0 decodes and writes in turn on\n"
+        "    one thread. Only one loaded file is held besides.\n\n"
         "Returns\n"
         "-------\n"
-        "dict\n"
-        "    columns : list of numpy arrays (int8/int16/float32/float64)\n"
-        "    sensor_names : list of str\n"
-        "    sensor_units : list of str\n"
-        "    sensor_sizes : list of int (1, 2, 4, or 8)\n"
-        "    n_records : int\n"
-        "    n_files : int"
+        "tuple of (n_records, n_files)"
+    );
+
+    m.def("write_dbd_netcdf_outputs",
+        [](const std::vector<std::string>& filenames,
+           const std::vector<std::pair<std::string, std::vector<std::string>>>& outputs,
+           const std::string& cache_dir,
+           const std::vector<std::string>& criteria,
+           const std::vector<std::string>& skip_missions,
+           const std::vector<std::string>& keep_missions,
+           bool skip_first_record,
+           bool repair,
+           int compression,
+           size_t chunk_size,
+           size_t n_threads,
+           size_t memory_budget) -> std::vector<std::pair<size_t, size_t>> {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("chunk_size must be positive");
+            }
+            if (compression < 0 || compression > 9) {
+                throw std::invalid_argument("compression must be 0-9");
+            }
+            std::vector<NetCDFOutput> outs;
+            outs.reserve(outputs.size());
+            for (const auto& out : outputs) outs.push_back({out.first, out.second});
+            py::gil_scoped_release release;
+            return write_netcdf_outputs(filenames, outs, cache_dir, criteria, skip_missions,
+                                        keep_missions, skip_first_record, repair, compression,
+                                        chunk_size, n_threads, memory_budget);
+        },
+        py::arg("filenames"),
+        py::arg("outputs"),
+        py::arg("cache_dir") = "",
+        py::arg("criteria") = std::vector<std::string>(),
+        py::arg("skip_missions") = std::vector<std::string>(),
+        py::arg("keep_missions") = std::vector<std::string>(),
+        py::arg("skip_first_record") = true,
+        py::arg("repair") = false,
+        py::arg("compression") = 5,
+        py::arg("chunk_size") = 65536,
+        py::arg("n_threads") = 1,
+        py::arg("memory_budget") = DEFAULT_WRITE_BUDGET,
+        "Stream multiple DBD files into several NetCDF-4 files in one pass.\n\n"
+        "As write_dbd_netcdf, but each output holds its own subset of the\n"
+        "sensors. The files are scanned, decompressed and decoded once, with\n"
+        "the union of the subsets as the plan, and every output is written\n"
+        "from its columns of each chunk. Each output has what write_dbd_netcdf\n"
+        "with its to_keep writes, unless a file's sensor sizes conflict only\n"
+        "with sensors of another output, which skips that file for all of them.\n"
+        "Only present when built with the XDBD_NETCDF_WRITER CMake option.\n\n"
+        "Parameters\n"
+        "----------\n"
+        "filenames : list of str\n"
+        "    Paths to DBD files.\n"
+        "outputs : list of (str, list of str)\n"
+        "    NetCDF file to create and the sensor names it keeps; an empty\n"
+        "    list keeps all. Existing files are overwritten.\n"
+        "cache_dir : str, optional\n"
+        "    Directory containing sensor cache files (.cac/.ccc).\n"
+        "criteria : list of str, optional\n"
+        "    Sensor names used for record selection criteria.\n"
+        "skip_missions : list of str, optional\n"
+        "    Mission names to exclude.\n"
+        "keep_missions : list of str, optional\n"
+        "    Mission names to include (excludes all others).\n"
+        "skip_first_record : bool, optional\n"
+        "    If True (default), skip first record of each file except the first.\n"
+        "repair : bool, optional\n"
+        "    If True, attempt to recover data from corrupted records.\n"
+        "compression : int, optional\n"
+        "    Zlib level 0-9 (default 5, 0 disables compression).\n"
+        "chunk_size : int, optional\n"
+        "    Most records decoded and written at a time (default 65536).\n"
+        "n_threads : int, optional\n"
+        "    Number of threads scanning headers. 1 (default) runs serially,\n"
+        "    0 uses all hardware threads.\n"
+        "memory_budget : int, optional\n"
+        "    Bytes of decoded chunks held between decoding and writing\n"
+        "    (default 256 MiB): as many chunks as fit, 2 to 8, with chunks\n"
+        "    shortened if two do not fit. 0 decodes and writes in turn on\n"
+        "    one thread. Only one loaded file is held besides.\n\n"
+        "Returns\n"
+        "-------\n"
+        "list of (n_records, n_files)\n"
+        "    One per output, (0, 0) for one that was not created."
     );
+#else
+    m.attr("has_netcdf_writer") = false;
+#endif // HAVE_NETCDF
 
     m.def("scan_sensors",
         [](const std::vector<std::string>& filenames,
            const std::string& cache_dir,
            const std::vector<std::string>& skip_missions,
-           const std::vector<std::string>& keep_missions) -> py::dict {
+           const std::vector<std::string>& keep_missions,
+           size_t n_threads) -> py::dict {
             SensorListResult result;
             {
                 py::gil_scoped_release release;
                 result = scan_sensor_list(filenames, cache_dir,
-                                          skip_missions, keep_missions);
+                                          skip_missions, keep_missions, n_threads);
             }
             py::list sensor_names;
             py::list sensor_units;
@@ -661,10 +3086,11 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         py::arg("cache_dir") = "",
         py::arg("skip_missions") = std::vector<std::string>(),
         py::arg("keep_missions") = std::vector<std::string>(),
+        py::arg("n_threads") = 1,
         "Scan DBD file headers and return the unified sensor list without reading data.\n\n"
         "Performs only pass 1 of the two-pass approach: opens each file, reads\n"
         "the header and sensor definitions, and builds a merged sensor list\n"
-        "via SensorsMap. No binary data is read.\n\n"
+        "via SensorsMap from the start of each file. No binary data is read.\n\n"
         "Parameters\n"
         "----------\n"
         "filenames : list of str\n"
@@ -674,7 +3100,11 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         "skip_missions : list of str, optional\n"
         "    Mission names to exclude.\n"
         "keep_missions : list of str, optional\n"
-        "    Mission names to include (excludes all others).\n\n"
+        "    Mission names to include (excludes all others).\n"
+        "n_threads : int, optional\n"
+        "    Number of threads scanning files. 1 (default) scans serially,\n"
+        "    0 uses all hardware threads. Output is identical for any\n"
+        "    thread count.\n\n"
         "Returns\n"
         "-------\n"
         "dict\n"
@@ -688,11 +3118,12 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
     m.def("scan_headers",
         [](const std::vector<std::string>& filenames,
            const std::vector<std::string>& skip_missions,
-           const std::vector<std::string>& keep_missions) -> py::dict {
+           const std::vector<std::string>& keep_missions,
+           size_t n_threads) -> py::dict {
             HeaderScanResult result;
             {
                 py::gil_scoped_release release;
-                result = scan_file_headers(filenames, skip_missions, keep_missions);
+                result = scan_file_headers(filenames, skip_missions, keep_missions, n_threads);
             }
             py::list out_filenames;
             py::list out_missions;
@@ -714,10 +3145,12 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         py::arg("filenames"),
         py::arg("skip_missions") = std::vector<std::string>(),
         py::arg("keep_missions") = std::vector<std::string>(),
+        py::arg("n_threads") = 1,
         "Scan DBD file headers and return per-file mission names and CRCs.\n\n"
         "Opens each file and reads only the ASCII header (no sensor definitions\n"
-        "or binary data). Useful for discovering which missions and cache CRCs\n"
-        "are present before a full read.\n\n"
+        "or binary data), from the first few KiB of the file. Useful for\n"
+        "discovering which missions and cache CRCs are present before a full\n"
+        "read.\n\n"
         "Parameters\n"
         "----------\n"
         "filenames : list of str\n"
@@ -725,7 +3158,11 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         "skip_missions : list of str, optional\n"
         "    Mission names to exclude.\n"
         "keep_missions : list of str, optional\n"
-        "    Mission names to include (excludes all others).\n\n"
+        "    Mission names to include (excludes all others).\n"
+        "n_threads : int, optional\n"
+        "    Number of threads scanning files. 1 (default) scans serially,\n"
+        "    0 uses all hardware threads. Output is identical for any\n"
+        "    thread count.\n\n"
         "Returns\n"
         "-------\n"
         "dict\n"
@@ -734,4 +3171,107 @@ PYBIND11_MODULE(_dbd_cpp, m, py::mod_gil_not_used()) {
         "    sensor_list_crcs : list of str\n"
         "    fileopen_times : list of str"
     );
+
+    m.def("sensor_cache_info",
+        []() -> py::dict {
+            const SensorsCache::Stats st = SensorsCache::instance().stats();
+            py::list entries;
+            for (const auto& key : st.keys) {
+                entries.append(py::make_tuple(key.first, key.second));
+            }
+            py::dict out;
+            out["size"] = st.size;
+            out["capacity"] = st.capacity;
+            out["hits"] = st.hits;
+            out["misses"] = st.misses;
+            out["entries"] = entries;
+            return out;
+        },
+        "Return the state of the process-wide parsed sensor list cache.\n\n"
+        "Sensor definitions are cached by (cache_dir, sensor_list_crc) across\n"
+        "calls, so repeated reads do not re-parse them.\n\n"
+        "Returns\n"
+        "-------\n"
+        "dict\n"
+        "    size : int (number of cached sensor lists)\n"
+        "    capacity : int (maximum number kept)\n"
+        "    hits : int\n"
+        "    misses : int\n"
+        "    entries : list of (cache_dir, crc) tuples, most recently used first"
+    );
+
+    m.def("clear_sensor_cache",
+        []() {
+            SensorsCache::instance().clear();
+            SensorCacheIndex::instance().clear();
+        },
+        "Drop all cached sensor lists and cache directory indexes.\n\n"
+        "Also resets the hit and miss counters of sensor_cache_info()."
+    );
+
+    m.def("set_sensor_cache_capacity",
+        [](size_t capacity) {
+            SensorsCache::instance().capacity(capacity);
+        },
+        py::arg("capacity"),
+        "Set the maximum number of cached sensor lists (0 disables caching).\n\n"
+        "Least recently used lists are dropped first."
+    );
+
+    m.def("enable_stats",
+        [](bool enabled) { ReadStats::enable(enabled); },
+        py::arg("enabled") = true,
+        "Turn read path instrumentation on or off (off by default).\n\n"
+        "While off, the counters and timers reported by get_stats() cost one\n"
+        "relaxed atomic load per probe and are not updated."
+    );
+
+    m.def("reset_stats",
+        []() { ReadStats::reset(); },
+        "Zero every counter and timer reported by get_stats()."
+    );
+
+    m.def("get_stats",
+        []() -> py::dict {
+            const ReadStats::Snapshot snap = ReadStats::snapshot();
+            py::dict stages;
+            for (size_t i = 0; i < ReadStats::N_STAGES; ++i) {
+                const ReadStats::StageTotals& t = snap.stages[i];
+                py::dict stage;
+                stage["calls"] = t.calls;
+                stage["wall_s"] = t.wall;
+                stage["cpu_s"] = t.cpu;
+                stages[ReadStats::name(static_cast<ReadStats::Stage>(i))] = stage;
+            }
+            py::dict out;
+            out["enabled"] = snap.qEnabled;
+            out["stages"] = stages;
+            for (size_t i = 0; i < ReadStats::N_COUNTERS; ++i) {
+                out[ReadStats::name(static_cast<ReadStats::Counter>(i))] = snap.counters[i];
+            }
+            return out;
+        },
+        "Return the read path counters and per-stage timers since the last\n"
+        "reset_stats(), gathered while enable_stats() was on.\n\n"
+        "Stage times are summed over threads, so with n_threads > 1 they can\n"
+        "exceed the elapsed time, and stages nest: scan includes the\n"
+        "cache_lookup and decompress work it does.\n\n"
+        "Returns\n"
+        "-------\n"
+        "dict\n"
+        "    enabled : bool\n"
+        "    stages : dict of stage -> {calls, wall_s, cpu_s}, for scan (pass 1,\n"
+        "        scan_sensors, scan_headers), cache_lookup (finding sensor list\n"
+        "        files), decompress (LZ4), count (record pre-scans), decode\n"
+        "        (read_columns) and convert (building Python results)\n"
+        "    bytes_read, bytes_decompressed : int\n"
+        "    records_decoded : int (records the decoder walked)\n"
+        "    codes_absent, codes_repeat, codes_new : int (state codes 0, 1, 2\n"
+        "        of those records)\n"
+        "    column_regrowths : int (column buffers grown to hold more rows)\n"
+        "    sensor_cache_hits, sensor_cache_misses : int (parsed sensor lists)\n"
+        "    cache_dir_scans : int (cache directory listings)\n"
+        "    record_index_hits, record_index_misses : int (record index sidecars)\n"
+        "    column_cache_hits, column_cache_misses : int (column cache files)"
+    );
 }
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+Compare two dbd_bench JSON runs and flag slowdowns
+
+Matches results by stage and corpus, prints the change in each stage's
+fastest pass, and exits with status 1 if any stage got slower than the
+threshold, so a parser change can be checked against a saved baseline.
+
+Usage:
+    cmake -S . -B build -DXDBD_BENCHMARKS=ON
+    cmake --build build --target benchmark        # writes build/dbd_bench.json
+    python scripts/compare_bench.py baseline.json build/dbd_bench.json
+    python scripts/compare_bench.py --threshold 5 baseline.json build/dbd_bench.json
+"""
+
+from __future__ import annotations
+
+import json
+import sys
+from argparse import ArgumentParser
+from pathlib import Path
+
+
+def load(path: Path) -> dict[tuple[str, str], dict]:
+    with open(path) as f:
+        data = json.load(f)
+    return {(r["name"], r["corpus"]): r for r in data["results"]}
+
+
+def main() -> None:
+    parser = ArgumentParser(description="Compare two dbd_bench JSON results")
+    parser.add_argument("baseline", type=Path, help="dbd_bench JSON to compare against")
+    parser.add_argument("current", type=Path, help="dbd_bench JSON of the change")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        help="Percent slowdown of a stage's best time that counts as a regression (default 10)",
+    )
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = []
+    print(f"{'stage':<20} {'corpus':<8} {'baseline ms':>12} {'current ms':>12} {'change':>8}")
+    for key in sorted(baseline.keys() | current.keys()):
+        name, corpus = key
+        if key not in baseline or key not in current:
+            where = "current" if key in current else "baseline"
+            print(f"{name:<20} {corpus:<8} only in {where}")
+            continue
+        old = baseline[key]["best_s"]
+        new = current[key]["best_s"]
+        change = 100.0 * (new - old) / old if old > 0 else 0.0
+        flag = " *" if change > args.threshold else ""
+        print(f"{name:<20} {corpus:<8} {old * 1e3:12.3f} {new * 1e3:12.3f} {change:+7.1f}%{flag}")
+        if flag:
+            regressions.append(key)
+
+    if regressions:
+        print(f"\n{len(regressions)} stage(s) slower by more than {args.threshold:g}%")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,6 +5,7 @@ from __future__ import annotations
 import tempfile
 from pathlib import Path
 
+import numpy as np
 import pytest
 import xarray as xr
 from conftest import CACHE_DIR, DBD_DIR, skip_no_data
@@ -283,3 +284,97 @@ class TestWriteMultiDbdNetcdf:
             ds.close()
         finally:
             Path(tmpname).unlink(missing_ok=True)
+
+    @pytest.mark.skipif(
+        not xdbd.backend.has_native_netcdf_writer(), reason="built without XDBD_NETCDF_WRITER"
+    )
+    def test_native_writer_matches_read(self):
+        """The native writer stores what read_dbd_files returns."""
+        files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))[:3]
+        if len(files) < 2:
+            pytest.skip("Need at least 2 .dcd files")
+
+        expected = xdbd.read_dbd_files(files, cache_dir=str(CACHE_DIR))
+        with tempfile.NamedTemporaryFile(suffix=".nc", delete=False) as tmp:
+            tmpname = tmp.name
+        try:
+            n_records, n_files = xdbd._dbd_cpp.write_dbd_netcdf(
+                files, tmpname, cache_dir=str(CACHE_DIR), chunk_size=1000
+            )
+            assert n_records == expected["n_records"]
+            assert n_files == expected["n_files"]
+            ds = xr.open_dataset(tmpname, decode_timedelta=False, mask_and_scale=False)
+            assert list(ds.data_vars) == list(expected["sensor_names"])
+            assert ds.attrs["total_records"] == n_records
+            for name, col in zip(expected["sensor_names"], expected["columns"], strict=True):
+                assert ds[name].dtype == col.dtype
+                np.testing.assert_array_equal(ds[name].values, col)
+            ds.close()
+        finally:
+            Path(tmpname).unlink(missing_ok=True)
+
+    def test_partitioned_write_matches_separate(self, tmp_path):
+        """One partitioned write gives each output what write_multi_dbd_netcdf does."""
+        files = sorted(DBD_DIR.glob("*.dcd"))[:3]
+        if len(files) < 2:
+            pytest.skip("Need at least 2 .dcd files")
+
+        scan = xdbd.scan_sensors([str(f) for f in files], cache_dir=str(CACHE_DIR))
+        names = list(scan["sensor_names"])
+        dbd = [n for n in names if n.startswith(("m_", "c_"))]
+        sci = [n for n in names if n.startswith("sci_")] + ["m_present_time"]
+        outputs = {
+            str(tmp_path / "dbd.nc"): dbd,
+            str(tmp_path / "sci.nc"): sci,
+            str(tmp_path / "none.nc"): ["totally_nonexistent_sensor_xyz"],
+            str(tmp_path / "all.nc"): None,
+        }
+        written = xdbd.write_partitioned_dbd_netcdf(files, outputs, cache_dir=CACHE_DIR)
+        assert list(written) == list(outputs)
+        assert written[str(tmp_path / "none.nc")] == (0, 0)
+        assert not (tmp_path / "none.nc").exists()
+
+        for ofn, keep in outputs.items():
+            if keep == ["totally_nonexistent_sensor_xyz"]:
+                continue
+            single = str(tmp_path / ("single." + Path(ofn).name))
+            assert written[ofn] == xdbd.write_multi_dbd_netcdf(
+                files, single, to_keep=keep, cache_dir=CACHE_DIR
+            )
+            with (
+                xr.open_dataset(ofn, decode_timedelta=False, mask_and_scale=False) as ds,
+                xr.open_dataset(single, decode_timedelta=False, mask_and_scale=False) as expected,
+            ):
+                assert list(ds.data_vars) == list(expected.data_vars)
+                assert ds.attrs == expected.attrs
+                for name in expected.data_vars:
+                    assert ds[name].dtype == expected[name].dtype
+                    assert ds[name].attrs["units"] == expected[name].attrs["units"]
+                    np.testing.assert_array_equal(ds[name].values, expected[name].values)
+
+    def test_memory_budget(self, tmp_path):
+        """Decoding ahead of the writer within any budget writes the same file."""
+        files = sorted(DBD_DIR.glob("*.dcd"))[:3]
+        if len(files) < 2:
+            pytest.skip("Need at least 2 .dcd files")
+
+        keep = ["m_present_time", "m_depth", "sci_water_temp"]
+        serial = str(tmp_path / "serial.nc")
+        expected = xdbd.write_multi_dbd_netcdf(
+            files, serial, to_keep=keep, cache_dir=CACHE_DIR, memory_budget=0
+        )
+        assert expected[0] > 0
+        for budget in (4096, 1 << 20, 256 << 20):
+            ofn = str(tmp_path / f"budget{budget}.nc")
+            written = xdbd.write_multi_dbd_netcdf(
+                files, ofn, to_keep=keep, cache_dir=CACHE_DIR, memory_budget=budget
+            )
+            assert written == expected
+            with (
+                xr.open_dataset(ofn, decode_timedelta=False, mask_and_scale=False) as ds,
+                xr.open_dataset(serial, decode_timedelta=False, mask_and_scale=False) as ref,
+            ):
+                assert list(ds.data_vars) == list(ref.data_vars)
+                assert ds.attrs == ref.attrs
+                for name in ref.data_vars:
+                    np.testing.assert_array_equal(ds[name].values, ref[name].values)
@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import asyncio
 import subprocess
 import tempfile
 from pathlib import Path
@@ -12,7 +13,14 @@ import xarray as xr
 from conftest import CACHE_DIR, CPP_REF_DIR, DBD_DIR, RAW_DIR
 
 import xarray_dbd as xdbd
-from xarray_dbd._dbd_cpp import read_dbd_file, read_dbd_files
+from xarray_dbd._dbd_cpp import (
+    open_dbd_append,
+    open_dbd_file,
+    read_dbd_file,
+    read_dbd_files,
+    read_dbd_files_iter,
+    submit_read,
+)
 
 
 def test_import():
@@ -38,6 +46,22 @@ def test_read_single_compressed_file():
         assert len(col) == n
 
 
+def test_uncompressed_matches_compressed():
+    """Memory-mapped .dbd decodes to the same columns as its LZ4 .dcd twin."""
+    dbd = DBD_DIR / "01330000.dbd"
+    dcd = DBD_DIR / "01330000.dcd"
+    if not dbd.exists():
+        pytest.skip("Uncompressed test file not available")
+
+    r_dbd = read_dbd_file(str(dbd), cache_dir=CACHE_DIR, skip_first_record=False)
+    r_dcd = read_dbd_file(str(dcd), cache_dir=CACHE_DIR, skip_first_record=False)
+
+    assert r_dbd["n_records"] == r_dcd["n_records"]
+    assert r_dbd["sensor_names"] == r_dcd["sensor_names"]
+    for a, b in zip(r_dbd["columns"], r_dcd["columns"], strict=True):
+        assert a.tobytes() == b.tobytes()
+
+
 def test_column_dtypes():
     """Columns have correct native dtypes based on sensor size."""
     f = str(DBD_DIR / "01330000.dcd")
@@ -101,6 +125,261 @@ def test_read_multiple_files():
     assert len(result["columns"]) == len(result["sensor_names"])
 
 
+def _assert_same_columns(dense, sparse):
+    densified = xdbd.densify(sparse)
+    assert "rows" not in densified
+    assert "counts" not in densified
+    assert densified["n_records"] == dense["n_records"]
+    assert densified["sensor_names"] == dense["sensor_names"]
+    for a, b in zip(dense["columns"], densified["columns"], strict=True):
+        assert a.dtype == b.dtype
+        np.testing.assert_array_equal(a, b)
+
+
+@pytest.mark.parametrize("skip_first_record", [True, False])
+def test_sparse_read(skip_first_record):
+    """A sparse read densifies to exactly the dense read."""
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))[:5]
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    dense = read_dbd_files(files, cache_dir=CACHE_DIR, skip_first_record=skip_first_record)
+    sparse = read_dbd_files(
+        files, cache_dir=CACHE_DIR, skip_first_record=skip_first_record, sparse=True
+    )
+    assert len(sparse["rows"]) == len(sparse["counts"]) == len(sparse["columns"])
+    assert sum(len(v) for v in sparse["columns"]) < sum(len(c) for c in dense["columns"])
+    for rows, counts, values in zip(
+        sparse["rows"], sparse["counts"], sparse["columns"], strict=True
+    ):
+        assert rows.dtype == counts.dtype == np.int64
+        assert len(rows) == len(counts) == len(values)
+        assert np.all(counts > 0)
+        assert np.all(rows[1:] >= rows[:-1] + counts[:-1])
+    _assert_same_columns(dense, sparse)
+
+    single = read_dbd_file(files[0], cache_dir=CACHE_DIR, skip_first_record=skip_first_record)
+    _assert_same_columns(
+        single,
+        read_dbd_file(
+            files[0], cache_dir=CACHE_DIR, skip_first_record=skip_first_record, sparse=True
+        ),
+    )
+
+
+def test_sparse_read_time_window(tmp_path):
+    """Time windows and ranges select the same rows of a sparse read."""
+    import shutil
+
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))[:5]
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    cache = tmp_path / "cache"
+    shutil.copytree(CACHE_DIR, cache)
+
+    t = read_dbd_files(files, cache_dir=CACHE_DIR, to_keep=["m_present_time"])["columns"][0]
+    start, end = np.nanpercentile(t, [25, 75])
+    kwargs = {
+        "cache_dir": str(cache),
+        "time_start": start,
+        "time_end": end,
+        "ranges": {"m_depth": (1.0, None)},
+    }
+    _assert_same_columns(
+        read_dbd_files(files, **kwargs), read_dbd_files(files, sparse=True, **kwargs)
+    )
+
+
+@pytest.mark.parametrize("n_threads", [0, 2, 4])
+def test_read_multiple_files_threaded(n_threads):
+    """Parallel decoding produces the same output as the serial path."""
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    serial = read_dbd_files(files, cache_dir=CACHE_DIR, n_threads=1)
+    threaded = read_dbd_files(files, cache_dir=CACHE_DIR, n_threads=n_threads)
+
+    assert threaded["n_records"] == serial["n_records"]
+    assert threaded["n_files"] == serial["n_files"]
+    assert threaded["sensor_names"] == serial["sensor_names"]
+    for a, b in zip(serial["columns"], threaded["columns"], strict=True):
+        assert a.dtype == b.dtype
+        assert a.tobytes() == b.tobytes()
+
+
+@pytest.mark.parametrize("n_threads", [0, 4])
+def test_scans_threaded(n_threads):
+    """Parallel header and sensor scans return the serial results, in order."""
+    from xarray_dbd._dbd_cpp import scan_headers, scan_sensors
+
+    files = sorted(str(f) for f in DBD_DIR.glob("*.[de]?d"))
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+    files = files[::-1] + [str(DBD_DIR / "missing.dbd")]
+
+    assert scan_headers(files, n_threads=n_threads) == scan_headers(files)
+    assert scan_sensors(files, cache_dir=CACHE_DIR, n_threads=n_threads) == scan_sensors(
+        files, cache_dir=CACHE_DIR
+    )
+
+
+def test_columns_share_one_buffer():
+    """All columns of a result are views of one arena that outlives the dict."""
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))[:3]
+    if not files:
+        pytest.skip("Test data not available")
+
+    result = read_dbd_files(files, cache_dir=CACHE_DIR)
+    columns = result["columns"]
+    assert len(columns) > 1
+    assert len({id(c.base) for c in columns}) == 1
+
+    idx = result["sensor_names"].index("m_present_time")
+    expected = columns[idx].copy()
+    kept = columns[idx]
+    del result, columns
+    read_dbd_files(files, cache_dir=CACHE_DIR)  # May reuse freed arena memory
+    assert kept.tobytes() == expected.tobytes()
+
+
+@pytest.mark.parametrize("chunk_size", [500, 65536])
+def test_read_multiple_files_iter(chunk_size):
+    """Concatenated chunks are identical to a whole read_dbd_files result."""
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    whole = read_dbd_files(files, cache_dir=CACHE_DIR)
+    chunks = read_dbd_files_iter(files, cache_dir=CACHE_DIR, chunk_size=chunk_size)
+    assert chunks.sensor_names == whole["sensor_names"]
+    assert chunks.n_files == whole["n_files"]
+
+    parts = list(chunks)
+    assert all(0 < p["n_records"] <= chunk_size for p in parts)
+    assert sum(p["n_records"] for p in parts) == whole["n_records"]
+    for i, col in enumerate(whole["columns"]):
+        joined = np.concatenate([p["columns"][i] for p in parts])
+        assert joined.dtype == col.dtype
+        assert joined.tobytes() == col.tobytes()
+
+
+def test_read_multiple_files_iter_rejects_zero_chunk():
+    """chunk_size must be positive."""
+    with pytest.raises(ValueError):
+        read_dbd_files_iter([], chunk_size=0)
+
+
+def test_read_multiple_files_time_window(tmp_path):
+    """A time window returns the full read's rows inside it, with or without an index."""
+    import shutil
+
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    cache = tmp_path / "cache"
+    shutil.copytree(CACHE_DIR, cache)
+
+    whole = read_dbd_files(files, cache_dir=CACHE_DIR)
+    t = whole["columns"][whole["sensor_names"].index("m_present_time")]
+    start, end = np.nanpercentile(t, [40, 45])
+    mask = (t >= start) & (t <= end)
+
+    for _ in range(2):  # The first read writes the index, the second uses it
+        part = read_dbd_files(files, cache_dir=str(cache), time_start=start, time_end=end)
+        assert part["n_records"] == mask.sum()
+        assert part["n_files"] == whole["n_files"]
+        for a, b in zip(whole["columns"], part["columns"], strict=True):
+            assert a[mask].tobytes() == b.tobytes()
+    assert len(list((cache / "index").glob("*.rix"))) == len(files)
+
+    kept = read_dbd_files(files, cache_dir=str(cache), to_keep=["m_depth"], time_start=start)
+    assert set(kept["sensor_names"]) == {"m_depth", "m_present_time"}
+    assert kept["n_records"] == (t >= start).sum()
+
+    with pytest.raises(ValueError, match="not in any file"):
+        read_dbd_files(files, cache_dir=CACHE_DIR, time_end=end, time_sensor="no_such_sensor")
+
+
+def test_time_window_and_ranges_pushdown():
+    """Rows filtered while decoding equal the unfiltered rows that pass."""
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    single = read_dbd_file(files[0], cache_dir=CACHE_DIR)
+    t = single["columns"][single["sensor_names"].index("m_present_time")]
+    start = np.nanpercentile(t, 75)
+    part = read_dbd_file(files[0], cache_dir=CACHE_DIR, time_start=start)
+    mask = t >= start
+    assert part["n_records"] == mask.sum()
+    for a, b in zip(single["columns"], part["columns"], strict=True):
+        assert a[mask].tobytes() == b.tobytes()
+
+    whole = read_dbd_files(files, cache_dir=CACHE_DIR, criteria=["m_depth"])
+    depth = whole["columns"][whole["sensor_names"].index("m_depth")]
+    part = read_dbd_files(
+        files, cache_dir=CACHE_DIR, criteria=["m_depth"], ranges={"m_depth": (5.0, None)}
+    )
+    mask = depth >= 5.0
+    assert part["n_records"] == mask.sum()
+    for a, b in zip(whole["columns"], part["columns"], strict=True):
+        assert a[mask].tobytes() == b.tobytes()
+
+
+@pytest.mark.parametrize("name", ["01330000.dbd", "01330000.dcd"])
+def test_append_reader_growing_file(tmp_path, name):
+    """Reads of a growing file concatenate to one read of the whole file."""
+    src = DBD_DIR / name
+    if not src.exists():
+        pytest.skip(f"{name} not available")
+
+    data = src.read_bytes()
+    dst = tmp_path / name
+    cuts = [len(data) // 2, len(data) * 2 // 3, len(data) * 2 // 3 + 7, len(data)]
+    dst.write_bytes(data[: cuts[0]])
+
+    reader = open_dbd_append(str(dst), cache_dir=CACHE_DIR)
+    parts = [reader.read()]
+    for cut in cuts[1:]:
+        dst.write_bytes(data[:cut])
+        parts.append(reader.read())
+    assert reader.read()["n_records"] == 0
+
+    whole = read_dbd_file(str(src), cache_dir=CACHE_DIR)
+    assert reader.n_records == whole["n_records"]
+    assert sum(p["n_records"] for p in parts) == whole["n_records"]
+    for i, col in enumerate(whole["columns"]):
+        joined = np.concatenate([p["columns"][i] for p in parts])
+        assert joined.dtype == col.dtype
+        assert joined.tobytes() == col.tobytes()
+
+
+@pytest.mark.parametrize("skip_first_record", [True, False])
+@pytest.mark.parametrize("name", ["01330000.dbd", "01330000.dcd"])
+def test_file_handle_reads(name, skip_first_record):
+    """Each read of a file handle matches read_dbd_file with the same to_keep."""
+    src = DBD_DIR / name
+    if not src.exists():
+        pytest.skip(f"{name} not available")
+
+    handle = open_dbd_file(str(src), cache_dir=CACHE_DIR, skip_first_record=skip_first_record)
+    for to_keep in ([], ["m_present_time"], ["m_depth", "m_lat", "sci_water_temp"], ["nope"]):
+        part = handle.read(to_keep)
+        whole = read_dbd_file(
+            str(src), cache_dir=CACHE_DIR, to_keep=to_keep, skip_first_record=skip_first_record
+        )
+        named = [i for i, n in enumerate(whole["sensor_names"]) if n]
+        assert part["sensor_names"] == [whole["sensor_names"][i] for i in named]
+        assert part["n_records"] == whole["n_records"] == handle.n_records
+        assert part["header"] == whole["header"]
+        for col, i in zip(part["columns"], named, strict=True):
+            assert col.dtype == whole["columns"][i].dtype
+            assert col.tobytes() == whole["columns"][i].tobytes()
+
+
 def test_open_multi_dbd_dataset():
     """open_multi_dbd_dataset returns correct Dataset."""
     files = sorted(DBD_DIR.glob("*.dcd"))[:5]
@@ -297,6 +576,24 @@ def test_to_keep_filters_sensors():
     ds_filtered.close()
 
 
+def test_to_keep_matches_full_read():
+    """Projected columns are identical to the same columns of a full read."""
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if len(files) < 2:
+        pytest.skip("Need at least 2 test files")
+
+    full = read_dbd_files(files, cache_dir=CACHE_DIR)
+    keep = ["m_present_time", "m_depth", "m_lat", "m_lon", "m_roll"]
+    kept = read_dbd_files(files, cache_dir=CACHE_DIR, to_keep=keep)
+
+    assert kept["n_records"] == full["n_records"]
+    assert sorted(kept["sensor_names"]) == sorted(keep)
+    columns = dict(zip(full["sensor_names"], full["columns"], strict=True))
+    for name, col in zip(kept["sensor_names"], kept["columns"], strict=True):
+        assert col.dtype == columns[name].dtype
+        assert col.tobytes() == columns[name].tobytes()
+
+
 @pytest.mark.skipif(not (DBD_DIR / "01330000.dcd").exists(), reason="Test data not available")
 def test_column_record_consistency():
     """All columns have exactly n_records rows."""
@@ -328,3 +625,216 @@ def test_read_file_types(ext):
     assert result["n_records"] >= 0
     assert len(result["sensor_names"]) > 0
     assert len(result["columns"]) == len(result["sensor_names"])
+
+
+@pytest.mark.skipif(not (DBD_DIR / "01330000.dbd").exists(), reason="Test data not available")
+def test_cache_dir_changes_are_seen(tmp_path):
+    """Cache files added after a failed lookup are found on the next read."""
+    import shutil
+
+    f = str(DBD_DIR / "01330000.dbd")
+    cache = tmp_path / "cache"
+    cache.mkdir()
+    with pytest.raises(RuntimeError, match="No sensors found"):
+        read_dbd_file(f, cache_dir=str(cache), skip_first_record=False)
+
+    for src in Path(CACHE_DIR).iterdir():
+        shutil.copy(src, cache / src.name)
+    result = read_dbd_file(f, cache_dir=str(cache), skip_first_record=False)
+    expected = read_dbd_file(f, cache_dir=CACHE_DIR, skip_first_record=False)
+    assert result["n_records"] == expected["n_records"]
+
+
+@pytest.mark.skipif(not (DBD_DIR / "01330000.dcd").exists(), reason="Test data not available")
+def test_sensor_cache_reuse():
+    """Parsed sensor lists are cached across calls and can be cleared."""
+    from xarray_dbd._dbd_cpp import (
+        clear_sensor_cache,
+        sensor_cache_info,
+        set_sensor_cache_capacity,
+    )
+
+    f = str(DBD_DIR / "01330000.dcd")
+    clear_sensor_cache()
+    first = read_dbd_file(f, cache_dir=CACHE_DIR, skip_first_record=False)
+    info = sensor_cache_info()
+    assert info["size"] >= 1
+    assert info["entries"][0][1] == first["header"]["sensor_list_crc"].lower()
+
+    second = read_dbd_file(f, cache_dir=CACHE_DIR, skip_first_record=False, to_keep=["m_depth"])
+    assert sensor_cache_info()["hits"] > info["hits"]
+    assert second["sensor_names"] == ["m_depth"]
+
+    # A filtered read must not leak its keep flags into the cached list
+    third = read_dbd_file(f, cache_dir=CACHE_DIR, skip_first_record=False)
+    assert third["sensor_names"] == first["sensor_names"]
+
+    clear_sensor_cache()
+    info = sensor_cache_info()
+    assert info["size"] == 0
+    assert info["hits"] == 0
+
+    set_sensor_cache_capacity(0)
+    try:
+        read_dbd_file(f, cache_dir=CACHE_DIR, skip_first_record=False)
+        assert sensor_cache_info()["size"] == 0
+    finally:
+        set_sensor_cache_capacity(64)
+
+
+@pytest.mark.skipif(not DBD_DIR.exists(), reason="Test data not available")
+def test_read_stats():
+    """get_stats reports the read path counters only while enabled."""
+    from xarray_dbd._dbd_cpp import enable_stats, get_stats, reset_stats
+
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if not files:
+        pytest.skip("No .dcd files")
+
+    enable_stats()
+    try:
+        reset_stats()
+        result = read_dbd_files(files, cache_dir=CACHE_DIR)
+        stats = get_stats()
+    finally:
+        enable_stats(False)
+
+    assert stats["enabled"]
+    assert stats["bytes_read"] > 0
+    assert stats["bytes_decompressed"] > 0
+    assert stats["records_decoded"] >= result["n_records"]
+    codes = stats["codes_absent"] + stats["codes_repeat"] + stats["codes_new"]
+    assert codes > 0
+    assert stats["stages"]["decode"]["calls"] > 0
+    assert stats["stages"]["scan"]["wall_s"] > 0
+
+    # Disabled, nothing is counted
+    read_dbd_files(files, cache_dir=CACHE_DIR)
+    assert get_stats()["records_decoded"] == stats["records_decoded"]
+
+    reset_stats()
+    stats = get_stats()
+    assert not stats["enabled"]
+    assert stats["records_decoded"] == 0
+    assert stats["stages"]["decode"]["calls"] == 0
+
+
+@pytest.mark.skipif(not DBD_DIR.exists(), reason="Test data not available")
+def test_column_cache(tmp_path):
+    """Reads through the column cache match decoding the files."""
+    import shutil
+
+    from xarray_dbd._dbd_cpp import enable_stats, get_stats, reset_stats
+
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))
+    if not files:
+        pytest.skip("No .dcd files")
+
+    cache = tmp_path / "cache"
+    shutil.copytree(CACHE_DIR, cache)
+    to_keep = ["m_present_time", "m_depth", "m_lat", "m_lon"]
+
+    expected = read_dbd_files(files, cache_dir=CACHE_DIR, to_keep=to_keep)
+    enable_stats()
+    try:
+        reset_stats()
+        first = read_dbd_files(files, cache_dir=str(cache), to_keep=to_keep, column_cache=True)
+        assert get_stats()["column_cache_misses"] == len(files)
+        assert list(cache.glob("columns/*.dcol"))
+
+        reset_stats()
+        second = read_dbd_files(files, cache_dir=str(cache), to_keep=to_keep, column_cache=True)
+        stats = get_stats()
+    finally:
+        enable_stats(False)
+    assert stats["column_cache_hits"] == len(files)
+    assert stats["column_cache_misses"] == 0
+
+    for result in (first, second):
+        assert result["n_records"] == expected["n_records"]
+        assert result["sensor_names"] == expected["sensor_names"]
+        for a, b in zip(result["columns"], expected["columns"], strict=True):
+            np.testing.assert_array_equal(a, b)
+
+    # A single file read maps the cached columns, read-only
+    single = read_dbd_file(files[0], cache_dir=str(cache), column_cache=True)
+    plain = read_dbd_file(files[0], cache_dir=CACHE_DIR)
+    assert single["sensor_names"] == plain["sensor_names"]
+    for a, b in zip(single["columns"], plain["columns"], strict=True):
+        np.testing.assert_array_equal(a, b)
+    assert not single["columns"][0].flags.writeable
+
+    with pytest.raises(ValueError, match="column_cache needs a cache_dir"):
+        read_dbd_files(files, column_cache=True)
+
+
+def _flip_byte_order(data: bytes, sizes: list[int]) -> bytes:
+    """The .dbd file data with its known bytes and values byte swapped."""
+    buf = bytearray(data)
+    kb = buf.index(b"sa\x34\x12")  # 's', 'a', then int16 0x1234 little-endian
+    for off, size in ((2, 2), (4, 4), (8, 8)):
+        buf[kb + off : kb + off + size] = buf[kb + off : kb + off + size][::-1]
+
+    n_state = (len(sizes) + 3) // 4
+    pos = kb + 16
+    while pos + 1 + n_state <= len(buf) and buf[pos] == ord("d"):
+        state = buf[pos + 1 : pos + 1 + n_state]
+        pos += 1 + n_state
+        for i, size in enumerate(sizes):
+            if (state[i // 4] >> (6 - 2 * (i % 4))) & 3 == 2:  # New value
+                buf[pos : pos + size] = buf[pos : pos + size][::-1]
+                pos += size
+    return bytes(buf)
+
+
+@pytest.mark.skipif(not (DBD_DIR / "01330001.dbd").exists(), reason="Test data not available")
+def test_flipped_byte_order(tmp_path):
+    """A file written in the other byte order decodes to the same values."""
+    f = DBD_DIR / "01330001.dbd"
+    native = read_dbd_file(str(f), cache_dir=CACHE_DIR, skip_first_record=False)
+
+    flipped = tmp_path / f.name
+    flipped.write_bytes(_flip_byte_order(f.read_bytes(), native["sensor_sizes"]))
+
+    result = read_dbd_file(str(flipped), cache_dir=CACHE_DIR, skip_first_record=False)
+    assert result["n_records"] == native["n_records"]
+    assert result["sensor_names"] == native["sensor_names"]
+    for a, b in zip(result["columns"], native["columns"], strict=True):
+        np.testing.assert_array_equal(a, b)
+
+
+@pytest.mark.skipif(not DBD_DIR.exists(), reason="Test data not available")
+def test_submit_read():
+    """Submitted reads give the read_dbd_file results, collected or awaited."""
+    import threading
+
+    files = sorted(str(f) for f in DBD_DIR.glob("*.dcd"))[:6]
+    if not files:
+        pytest.skip("No .dcd files")
+    to_keep = ["m_present_time", "m_depth"]
+    expected = [read_dbd_file(f, cache_dir=CACHE_DIR, to_keep=to_keep) for f in files]
+
+    called = threading.Event()
+    futures = [submit_read(f, cache_dir=CACHE_DIR, to_keep=to_keep) for f in files]
+    futures[0].add_done_callback(lambda fut: called.set())
+    for fut, exp in zip(futures, expected, strict=True):
+        result = fut.result(timeout=60)
+        assert fut.done()
+        assert not fut.cancelled()
+        assert result["n_records"] == exp["n_records"]
+        assert result["sensor_names"] == exp["sensor_names"]
+        for a, b in zip(result["columns"], exp["columns"], strict=True):
+            np.testing.assert_array_equal(a, b)
+        assert fut.result() is result
+    assert called.wait(60)
+
+    async def gather():
+        return await asyncio.gather(
+            *(submit_read(f, cache_dir=CACHE_DIR, to_keep=to_keep) for f in files)
+        )
+
+    for result, exp in zip(asyncio.run(gather()), expected, strict=True):
+        assert result["n_records"] == exp["n_records"]
+
+    with pytest.raises(RuntimeError, match="Cannot open file"):
+        submit_read(str(DBD_DIR / "nonexistent.dbd")).result(timeout=60)
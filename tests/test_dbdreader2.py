@@ -389,6 +389,24 @@ class TestMultiDBD:
         assert len(t) == len(v0) == len(v1)
         mdbd.close()
 
+    def test_get_sync_matches_numpy_interp(self):
+        """get_sync equals numpy.interp of each parameter's get() onto the first."""
+        mdbd = MultiDBD(filenames=_all_files(), cacheDir=CACHE_DIR)
+        params = [
+            p
+            for p in ("m_depth", "m_pitch", "m_lat", "m_gps_lon", "sci_water_temp")
+            if mdbd.has_parameter(p)
+        ]
+        synced = mdbd.get_sync(*params)
+        t, v = mdbd.get(params[0])
+        np.testing.assert_array_equal(synced[0], t)
+        np.testing.assert_array_equal(synced[1], v)
+        for p, col in zip(params[1:], synced[2:], strict=True):
+            tp, vp = mdbd.get(p)
+            expected = np.interp(t, tp, vp, left=np.nan, right=np.nan)
+            np.testing.assert_allclose(col, expected, rtol=1e-12, atol=0)
+        mdbd.close()
+
     def test_get_xy(self):
         mdbd = MultiDBD(filenames=_all_files(), cacheDir=CACHE_DIR)
         x, y = mdbd.get_xy("m_depth", "m_pitch")
@@ -10,16 +10,23 @@ from __future__ import annotations
 from importlib.metadata import version
 
 from ._dbd_cpp import (
+    open_dbd_append,
+    open_dbd_file,
     read_dbd_file,
     read_dbd_files,
+    read_dbd_files_iter,
     scan_headers,
     scan_sensors,
+    set_executor_threads,
+    submit_read,
 )
 from .backend import (
     DBDBackendEntrypoint,
+    densify,
     open_dbd_dataset,
     open_multi_dbd_dataset,
     write_multi_dbd_netcdf,
+    write_partitioned_dbd_netcdf,
 )
 from .dbdreader2 import DBD, MultiDBD
 
@@ -28,11 +35,18 @@ __all__ = [
     "DBD",
     "DBDBackendEntrypoint",
     "MultiDBD",
+    "open_dbd_append",
+    "open_dbd_file",
     "read_dbd_file",
     "read_dbd_files",
+    "read_dbd_files_iter",
     "scan_headers",
     "scan_sensors",
+    "set_executor_threads",
+    "submit_read",
+    "densify",
     "open_dbd_dataset",
     "open_multi_dbd_dataset",
     "write_multi_dbd_netcdf",
+    "write_partitioned_dbd_netcdf",
 ]
@@ -1,9 +1,14 @@
 """Type stubs for the _dbd_cpp C++ extension module."""
 
+from collections.abc import Callable, Generator
 from typing import Any, TypedDict
 
+from typing_extensions import NotRequired
+
 class _SingleResult(TypedDict):
     columns: list[Any]
+    rows: NotRequired[list[Any]]
+    counts: NotRequired[list[Any]]
     sensor_names: list[str]
     sensor_units: list[str]
     sensor_sizes: list[int]
@@ -13,6 +18,8 @@ class _SingleResult(TypedDict):
 
 class _MultiResult(TypedDict):
     columns: list[Any]
+    rows: NotRequired[list[Any]]
+    counts: NotRequired[list[Any]]
     sensor_names: list[str]
     sensor_units: list[str]
     sensor_sizes: list[int]
@@ -26,12 +33,83 @@ class _ScanResult(TypedDict):
     valid_files: list[str]
     n_files: int
 
+class _SensorCacheInfo(TypedDict):
+    size: int
+    capacity: int
+    hits: int
+    misses: int
+    entries: list[tuple[str, str]]
+
+class _StageStats(TypedDict):
+    calls: int
+    wall_s: float
+    cpu_s: float
+
+class _ReadStats(TypedDict):
+    enabled: bool
+    stages: dict[str, _StageStats]
+    bytes_read: int
+    bytes_decompressed: int
+    records_decoded: int
+    codes_absent: int
+    codes_repeat: int
+    codes_new: int
+    column_regrowths: int
+    sensor_cache_hits: int
+    sensor_cache_misses: int
+    cache_dir_scans: int
+    record_index_hits: int
+    record_index_misses: int
+    column_cache_hits: int
+    column_cache_misses: int
+
 class _HeaderResult(TypedDict):
     filenames: list[str]
     mission_names: list[str]
     sensor_list_crcs: list[str]
     fileopen_times: list[str]
 
+class DBDChunkIterator:
+    @property
+    def sensor_names(self) -> list[str]: ...
+    @property
+    def sensor_units(self) -> list[str]: ...
+    @property
+    def sensor_sizes(self) -> list[int]: ...
+    @property
+    def n_files(self) -> int: ...
+    @property
+    def chunk_size(self) -> int: ...
+    def __iter__(self) -> DBDChunkIterator: ...
+    def __next__(self) -> _MultiResult: ...
+
+class DBDAppendReader:
+    @property
+    def filename(self) -> str: ...
+    @property
+    def n_records(self) -> int: ...
+    @property
+    def offset(self) -> int: ...
+    def read(self) -> _SingleResult: ...
+
+class DBDFileHandle:
+    @property
+    def filename(self) -> str: ...
+    @property
+    def n_records(self) -> int: ...
+    def read(self, to_keep: list[str] = ...) -> _SingleResult: ...
+
+class DBDReadFuture:
+    @property
+    def filename(self) -> str: ...
+    def done(self) -> bool: ...
+    def running(self) -> bool: ...
+    def cancelled(self) -> bool: ...
+    def cancel(self) -> bool: ...
+    def result(self, timeout: float | None = None) -> _SingleResult: ...
+    def add_done_callback(self, fn: Callable[[DBDReadFuture], object]) -> None: ...
+    def __await__(self) -> Generator[Any, None, _SingleResult]: ...
+
 def read_dbd_file(
     filename: str,
     cache_dir: str = "",
@@ -39,6 +117,12 @@ def read_dbd_file(
     criteria: list[str] = ...,
     skip_first_record: bool = True,
     repair: bool = False,
+    time_start: float | None = None,
+    time_end: float | None = None,
+    time_sensor: str = "",
+    ranges: dict[str, tuple[float | None, float | None]] = ...,
+    sparse: bool = False,
+    column_cache: bool = False,
 ) -> _SingleResult: ...
 def read_dbd_files(
     filenames: list[str],
@@ -49,15 +133,110 @@ def read_dbd_files(
     keep_missions: list[str] = ...,
     skip_first_record: bool = True,
     repair: bool = False,
+    n_threads: int = 1,
+    time_start: float | None = None,
+    time_end: float | None = None,
+    time_sensor: str = "",
+    ranges: dict[str, tuple[float | None, float | None]] = ...,
+    sparse: bool = False,
+    column_cache: bool = False,
 ) -> _MultiResult: ...
+def read_dbd_files_iter(
+    filenames: list[str],
+    cache_dir: str = "",
+    to_keep: list[str] = ...,
+    criteria: list[str] = ...,
+    skip_missions: list[str] = ...,
+    keep_missions: list[str] = ...,
+    skip_first_record: bool = True,
+    repair: bool = False,
+    chunk_size: int = 65536,
+) -> DBDChunkIterator: ...
+def open_dbd_append(
+    filename: str,
+    cache_dir: str = "",
+    to_keep: list[str] = ...,
+    criteria: list[str] = ...,
+    skip_first_record: bool = True,
+    repair: bool = False,
+) -> DBDAppendReader: ...
+def open_dbd_file(
+    filename: str,
+    cache_dir: str = "",
+    criteria: list[str] = ...,
+    skip_first_record: bool = True,
+    repair: bool = False,
+) -> DBDFileHandle: ...
+def submit_read(
+    filename: str,
+    cache_dir: str = "",
+    to_keep: list[str] = ...,
+    criteria: list[str] = ...,
+    skip_first_record: bool = True,
+    repair: bool = False,
+    time_start: float | None = None,
+    time_end: float | None = None,
+    time_sensor: str = "",
+    ranges: dict[str, tuple[float | None, float | None]] = ...,
+    sparse: bool = False,
+    column_cache: bool = False,
+) -> DBDReadFuture: ...
+def set_executor_threads(n_threads: int = 0) -> None: ...
+def sync_columns(
+    t: Any,
+    times: list[Any],
+    values: list[Any],
+    limits: list[float] = ...,
+    decimal: list[bool] = ...,
+    n_threads: int = 0,
+) -> tuple[list[Any], list[int]]: ...
+def write_dbd_netcdf(
+    filenames: list[str],
+    output: str,
+    cache_dir: str = "",
+    to_keep: list[str] = ...,
+    criteria: list[str] = ...,
+    skip_missions: list[str] = ...,
+    keep_missions: list[str] = ...,
+    skip_first_record: bool = True,
+    repair: bool = False,
+    compression: int = 5,
+    chunk_size: int = 65536,
+    n_threads: int = 1,
+    memory_budget: int = 268435456,
+) -> tuple[int, int]: ...
+def write_dbd_netcdf_outputs(
+    filenames: list[str],
+    outputs: list[tuple[str, list[str]]],
+    cache_dir: str = "",
+    criteria: list[str] = ...,
+    skip_missions: list[str] = ...,
+    keep_missions: list[str] = ...,
+    skip_first_record: bool = True,
+    repair: bool = False,
+    compression: int = 5,
+    chunk_size: int = 65536,
+    n_threads: int = 1,
+    memory_budget: int = 268435456,
+) -> list[tuple[int, int]]: ...
 def scan_sensors(
     filenames: list[str],
     cache_dir: str = "",
     skip_missions: list[str] = ...,
     keep_missions: list[str] = ...,
+    n_threads: int = 1,
 ) -> _ScanResult: ...
 def scan_headers(
     filenames: list[str],
     skip_missions: list[str] = ...,
     keep_missions: list[str] = ...,
+    n_threads: int = 1,
 ) -> _HeaderResult: ...
+def sensor_cache_info() -> _SensorCacheInfo: ...
+def clear_sensor_cache() -> None: ...
+def set_sensor_cache_capacity(capacity: int) -> None: ...
+def enable_stats(enabled: bool = True) -> None: ...
+def reset_stats() -> None: ...
+def get_stats() -> _ReadStats: ...
+
+has_netcdf_writer: bool
@@ -5,7 +5,9 @@ Xarray backend engine for DBD files using C++ parser
 from __future__ import annotations
 
 import logging
-from collections.abc import Iterable
+import queue
+import threading
+from collections.abc import Iterable, Iterator, Mapping
 from pathlib import Path
 from typing import Any
 
@@ -13,16 +15,19 @@ import numpy as np
 import xarray as xr
 from xarray.backends import BackendEntrypoint
 
-from ._dbd_cpp import read_dbd_file, read_dbd_files, scan_sensors
+from . import _dbd_cpp
+from ._dbd_cpp import read_dbd_file, read_dbd_files, read_dbd_files_iter, scan_sensors
 
 logger = logging.getLogger(__name__)
 
 __all__ = [
     "DBDDataStore",
     "DBDBackendEntrypoint",
+    "densify",
     "open_dbd_dataset",
     "open_multi_dbd_dataset",
     "write_multi_dbd_netcdf",
+    "write_partitioned_dbd_netcdf",
 ]
 
 
@@ -271,6 +276,7 @@ def open_multi_dbd_dataset(
     skip_missions: list[str] | None = None,
     keep_missions: list[str] | None = None,
     cache_dir: str | Path | None = None,
+    n_threads: int = 1,
 ) -> xr.Dataset:
     """Open multiple DBD files as a single concatenated xarray Dataset.
 
@@ -295,6 +301,9 @@ def open_multi_dbd_dataset(
         Mission names to include (excludes all others).
     cache_dir : str, Path, or None
         Directory for sensor cache files.
+    n_threads : int
+        Threads used to decode files concurrently (default 1, 0 = all cores).
+        The result is identical for any thread count.
 
     Returns
     -------
@@ -326,6 +335,7 @@ def open_multi_dbd_dataset(
             keep_missions=keep_missions or [],
             skip_first_record=skip_first_record,
             repair=repair,
+            n_threads=n_threads,
         )
     except RuntimeError as e:
         raise OSError(f"Failed to read {len(file_list)} DBD files: {e}") from e
@@ -370,6 +380,53 @@ _NC_TYPE_INFO = {
     8: ("f8", np.float64("nan")),
 }
 
+# Bytes of decoded chunks a NetCDF write holds by default, and the most
+# chunks it decodes ahead of the writer, as in the C++ writer
+_WRITE_BUDGET = 256 * 2**20
+_MAX_WRITE_CHUNKS = 8
+
+
+def has_native_netcdf_writer() -> bool:
+    """Whether write_multi_dbd_netcdf uses the C++ NetCDF-4 writer."""
+    return bool(getattr(_dbd_cpp, "has_netcdf_writer", False))
+
+
+def densify(result: dict[str, Any]) -> dict[str, Any]:
+    """Expand a ``sparse=True`` read into dense columns.
+
+    Parameters
+    ----------
+    result : dict
+        Result of :func:`read_dbd_file` or :func:`read_dbd_files` called
+        with ``sparse=True``: for each column, the value of every run in
+        ``columns`` and its first row and number of rows in ``rows`` and
+        ``counts``.
+
+    Returns
+    -------
+    dict
+        The same result without ``rows`` and ``counts``, and each column
+        expanded to ``n_records`` values, the fill value (NaN, -127 or
+        -32768) outside its runs, exactly as the read without ``sparse``
+        returns it. A dense result is returned unchanged.
+    """
+    if "rows" not in result:
+        return result
+    n = result["n_records"]
+    columns = []
+    for rows, counts, values, size in zip(
+        result["rows"], result["counts"], result["columns"], result["sensor_sizes"], strict=True
+    ):
+        fill = _NC_TYPE_INFO.get(size, _NC_TYPE_INFO[8])[1]
+        col = np.full(n, fill, dtype=values.dtype)
+        # Row t of run j is rows[j] + t; runs ascend and do not overlap
+        before = np.cumsum(counts) - counts
+        col[np.repeat(rows - before, counts) + np.arange(counts.sum())] = np.repeat(values, counts)
+        columns.append(col)
+    dense = {k: v for k, v in result.items() if k not in ("rows", "counts")}
+    dense["columns"] = columns
+    return dense
+
 
 def write_multi_dbd_netcdf(
     filenames: Iterable[str | Path],
@@ -383,13 +440,15 @@ def write_multi_dbd_netcdf(
     keep_missions: list[str] | None = None,
     cache_dir: str | Path | None = None,
     compression: int = 5,
+    memory_budget: int = _WRITE_BUDGET,
 ) -> tuple[int, int]:
     """Stream multiple DBD files directly to a NetCDF file.
 
     Unlike :func:`open_multi_dbd_dataset` which loads all data into memory,
-    this function reads one file at a time and writes its records to the
-    output NetCDF immediately, keeping peak memory proportional to a single
-    file's data.
+    this function decodes the files a chunk of records at a time on a
+    thread of its own and writes each chunk to the output NetCDF while the
+    next ones are decoded, keeping peak memory to ``memory_budget`` and a
+    single file's data.
 
     Parameters
     ----------
@@ -413,13 +472,22 @@ def write_multi_dbd_netcdf(
         Directory for sensor cache files.
     compression : int
         Zlib compression level 0-9 (default 5, 0 disables compression).
+    memory_budget : int
+        Bytes of decoded chunks held between decoding and writing (default
+        256 MiB): as many chunks as fit, 2 to 8, with chunks shortened if
+        two do not fit.  0 decodes and writes in turn on one thread.
 
     Returns
     -------
     tuple of (n_records, n_files)
-    """
-    import netCDF4
 
+    Notes
+    -----
+    When the extension is built with the native NetCDF-4 writer
+    (``XDBD_NETCDF_WRITER``), the files are decoded and written in C++
+    without the GIL and netCDF4 is not needed; the output is laid out the
+    same way.
+    """
     if skip_missions and keep_missions:
         raise ValueError("Cannot specify both skip_missions and keep_missions")
 
@@ -429,120 +497,306 @@ def write_multi_dbd_netcdf(
 
     cache_str = str(cache_dir) if cache_dir else ""
 
-    # Pass 1: scan sensor union and valid files in one pass
-    sensor_result = scan_sensors(
+    if has_native_netcdf_writer():
+        n_records, n_files = _dbd_cpp.write_dbd_netcdf(
+            file_list,
+            str(output),
+            cache_dir=cache_str,
+            to_keep=to_keep or [],
+            criteria=criteria or [],
+            skip_missions=skip_missions or [],
+            keep_missions=keep_missions or [],
+            skip_first_record=skip_first_record,
+            repair=repair,
+            compression=compression,
+            memory_budget=memory_budget,
+        )
+        return int(n_records), int(n_files)
+
+    ((n_records, n_files),) = _write_netcdf_python(
         file_list,
-        cache_dir=cache_str,
-        skip_missions=skip_missions or [],
-        keep_missions=keep_missions or [],
+        [(str(output), to_keep)],
+        skip_first_record=skip_first_record,
+        repair=repair,
+        criteria=criteria,
+        skip_missions=skip_missions,
+        keep_missions=keep_missions,
+        cache_str=cache_str,
+        compression=compression,
+        memory_budget=memory_budget,
     )
-    sensor_names = list(sensor_result["sensor_names"])
-    sensor_units = list(sensor_result["sensor_units"])
-    sensor_sizes = list(sensor_result["sensor_sizes"])
-    valid_files = list(sensor_result["valid_files"])
+    return n_records, n_files
 
-    if not valid_files or not sensor_names:
-        return 0, 0
 
-    # Apply to_keep filter to the union sensor list
-    if to_keep:
-        keep_set = set(to_keep)
-        indices = [i for i, n in enumerate(sensor_names) if n in keep_set]
-        sensor_names = [sensor_names[i] for i in indices]
-        sensor_units = [sensor_units[i] for i in indices]
-        sensor_sizes = [sensor_sizes[i] for i in indices]
+def write_partitioned_dbd_netcdf(
+    filenames: Iterable[str | Path],
+    outputs: Mapping[str | Path, list[str] | None],
+    *,
+    skip_first_record: bool = True,
+    repair: bool = False,
+    criteria: list[str] | None = None,
+    skip_missions: list[str] | None = None,
+    keep_missions: list[str] | None = None,
+    cache_dir: str | Path | None = None,
+    compression: int = 5,
+    memory_budget: int = _WRITE_BUDGET,
+) -> dict[str, tuple[int, int]]:
+    """Stream multiple DBD files into several NetCDF files in one pass.
 
-    if not sensor_names:
-        return 0, 0
+    Each output holds its own subset of the sensors, as a
+    :func:`write_multi_dbd_netcdf` call per output with that ``to_keep``
+    would write it, but the files are scanned, decompressed and decoded
+    only once, for the union of the subsets, e.g. for the dbd, sci and
+    other partitions of flight data.
 
-    # Build fill value lookup for sensors missing from a batch
-    fill_vals = {}
-    for name, size in zip(sensor_names, sensor_sizes, strict=True):
-        dtype, fill = _NC_TYPE_INFO.get(size, ("f8", np.float64("nan")))
-        fill_vals[name] = (dtype, fill)
+    Parameters
+    ----------
+    filenames : iterable of str or Path
+        Paths to DBD files.  Files are sorted internally.
+    outputs : mapping of str or Path to list of str or None
+        Output NetCDF file for each sensor subset; None keeps all sensors.
+    skip_first_record, repair, criteria, skip_missions, keep_missions, cache_dir, compression
+        As for :func:`write_multi_dbd_netcdf`.
+    memory_budget : int
+        As for :func:`write_multi_dbd_netcdf`, shared by all the outputs.
 
-    # Create NetCDF file with variables
-    chunk = 5000
-    nc = netCDF4.Dataset(str(output), "w", format="NETCDF4")
+    Returns
+    -------
+    dict
+        ``(n_records, n_files)`` for each output, keyed by its path as a
+        string; ``(0, 0)`` for an output not written because none of its
+        sensors are in the files.
+
+    Notes
+    -----
+    A file whose sensor sizes conflict with the union of all the subsets is
+    left out of every output, even where it would only conflict with
+    another output's sensors.
+    """
+    if skip_missions and keep_missions:
+        raise ValueError("Cannot specify both skip_missions and keep_missions")
+
+    targets = [(str(ofn), keep) for ofn, keep in outputs.items()]
+    file_list = sorted(str(Path(f)) for f in filenames)
+    if not file_list or not targets:
+        return {ofn: (0, 0) for ofn, _ in targets}
+
+    cache_str = str(cache_dir) if cache_dir else ""
+
+    if has_native_netcdf_writer():
+        written = _dbd_cpp.write_dbd_netcdf_outputs(
+            file_list,
+            [(ofn, list(keep or [])) for ofn, keep in targets],
+            cache_dir=cache_str,
+            criteria=criteria or [],
+            skip_missions=skip_missions or [],
+            keep_missions=keep_missions or [],
+            skip_first_record=skip_first_record,
+            repair=repair,
+            compression=compression,
+            memory_budget=memory_budget,
+        )
+    else:
+        written = _write_netcdf_python(
+            file_list,
+            targets,
+            skip_first_record=skip_first_record,
+            repair=repair,
+            criteria=criteria,
+            skip_missions=skip_missions,
+            keep_missions=keep_missions,
+            cache_str=cache_str,
+            compression=compression,
+            memory_budget=memory_budget,
+        )
+    return {
+        ofn: (int(n_records), int(n_files))
+        for (ofn, _), (n_records, n_files) in zip(targets, written, strict=True)
+    }
+
+
+def _prefetch(chunks: Iterator[dict[str, Any]], n_chunks: int) -> Iterator[dict[str, Any]]:
+    """Yield the items of chunks while a thread fetches the next ones.
+
+    At most n_chunks items exist at once, counting the one being fetched
+    and the one the caller holds, who must drop it before asking for the
+    next; with n_chunks below 2 there is no thread.
+    """
+    if n_chunks < 2:
+        yield from chunks
+        return
+
+    slots = threading.Semaphore(n_chunks)
+    ready: queue.Queue[Any] = queue.Queue()
+    stop = threading.Event()
+    done = object()
+
+    def fetch() -> None:
+        try:
+            while slots.acquire() and not stop.is_set():
+                item = next(chunks, done)
+                ready.put(item)
+                if item is done:
+                    return
+        except BaseException as e:  # Handed to the caller
+            ready.put(e)
+
+    thread = threading.Thread(target=fetch, daemon=True)
+    thread.start()
     try:
-        nc.createDimension("i", None)
-        for name, units in zip(sensor_names, sensor_units, strict=True):
-            dtype, _ = fill_vals[name]
-            if compression > 0:
-                v = nc.createVariable(  # type: ignore[call-overload]
-                    name,
-                    dtype,
-                    ("i",),
-                    fill_value=False,
-                    zlib=True,
-                    complevel=compression,
-                    chunksizes=(chunk,),
-                )
-            else:
-                v = nc.createVariable(name, dtype, ("i",), fill_value=False)
-            v.units = units
+        while True:
+            item = ready.get()
+            if item is done:
+                return
+            if isinstance(item, BaseException):
+                raise item
+            yield item
+            del item
+            slots.release()
     finally:
-        nc.close()
+        stop.set()
+        slots.release()  # Wakes a fetch waiting for a slot
+        thread.join()
 
-    # Pass 2: read files in batches, append to NetCDF
-    batch_size = 100
-    offset = 0
-    total_files = 0
 
-    for batch_idx in range(0, len(valid_files), batch_size):
-        batch_files = valid_files[batch_idx : batch_idx + batch_size]
+def _write_netcdf_python(
+    file_list: list[str],
+    outputs: list[tuple[str, list[str] | None]],
+    *,
+    skip_first_record: bool,
+    repair: bool,
+    criteria: list[str] | None,
+    skip_missions: list[str] | None,
+    keep_missions: list[str] | None,
+    cache_str: str,
+    compression: int,
+    memory_budget: int,
+) -> list[tuple[int, int]]:
+    """The netCDF4 writer behind write_multi_dbd_netcdf, for several outputs.
+
+    The files are read once, a chunk at a time with the union of the
+    outputs' sensors, and each output's columns of every chunk are
+    appended to its file while the next chunks are decoded.
+    """
+    import netCDF4
 
-        try:
-            result = read_dbd_files(
-                batch_files,
-                cache_dir=cache_str,
-                to_keep=to_keep or [],
-                criteria=criteria or [],
-                skip_missions=skip_missions or [],
-                keep_missions=keep_missions or [],
-                skip_first_record=skip_first_record,
-                repair=repair,
+    written = [(0, 0)] * len(outputs)
+
+    # Pass 1: scan sensor union and valid files in one pass
+    sensor_result = scan_sensors(
+        file_list,
+        cache_dir=cache_str,
+        skip_missions=skip_missions or [],
+        keep_missions=keep_missions or [],
+    )
+    all_names = list(sensor_result["sensor_names"])
+    all_units = list(sensor_result["sensor_units"])
+    all_sizes = list(sensor_result["sensor_sizes"])
+    valid_files = list(sensor_result["valid_files"])
+
+    if not valid_files or not all_names:
+        return written
+
+    # Apply each output's to_keep filter to the union sensor list
+    targets = []  # (output index, path, sensor names, units)
+    for k, (ofn, keep) in enumerate(outputs):
+        keep_set = set(keep) if keep else None
+        indices = [i for i, n in enumerate(all_names) if keep_set is None or n in keep_set]
+        if indices:
+            targets.append(
+                (k, ofn, [all_names[i] for i in indices], [all_units[i] for i in indices])
             )
-        except (OSError, RuntimeError, ValueError) as e:
-            logger.warning("Error reading batch starting at index %d: %s", batch_idx, e)
-            continue
 
-        n = int(result["n_records"])
-        batch_files_read = int(result["n_files"])
+    if not targets:
+        return written
 
-        # For batches after the first, the first file's first record overlaps
-        # with the previous batch's last file — skip it
-        start = 1 if (batch_idx > 0 and skip_first_record and n > 0) else 0
-        n_write = n - start
+    # Read only the sensors some output keeps; one keeping all keeps all
+    union_keep: list[str] = []
+    if all(keep for _, keep in outputs):
+        union_keep = list(dict.fromkeys(n for _, keep in outputs for n in keep or []))
 
-        total_files += batch_files_read
+    # Build fill value lookup for sensors missing from a chunk
+    fill_vals = {}
+    for name, size in zip(all_names, all_sizes, strict=True):
+        dtype, fill = _NC_TYPE_INFO.get(size, ("f8", np.float64("nan")))
+        fill_vals[name] = (dtype, fill)
 
-        if n_write <= 0:
-            continue
+    # Size the chunks to the budget as the C++ writer does
+    chunk_size = 65536
+    n_chunks = 1
+    if memory_budget > 0:
+        kept = set(union_keep) if union_keep else None
+        row_bytes = sum(
+            size
+            for name, size in zip(all_names, all_sizes, strict=True)
+            if kept is None or name in kept
+        )
+        chunk_size = max(1, min(chunk_size, memory_budget // (2 * row_bytes)))
+        n_chunks = min(max(memory_budget // (chunk_size * row_bytes), 2), _MAX_WRITE_CHUNKS)
 
-        # Build column map from this batch's result
-        result_names = list(result["sensor_names"])
-        result_cols = list(result["columns"])
-        col_map = dict(zip(result_names, result_cols, strict=True))
+    chunks = read_dbd_files_iter(
+        valid_files,
+        cache_dir=cache_str,
+        to_keep=union_keep,
+        criteria=criteria or [],
+        skip_missions=skip_missions or [],
+        keep_missions=keep_missions or [],
+        skip_first_record=skip_first_record,
+        repair=repair,
+        chunk_size=chunk_size,
+    )
 
-        # Append to NetCDF
-        nc = netCDF4.Dataset(str(output), "a")
-        try:
-            for name in sensor_names:
-                col = col_map.get(name)
-                if col is not None:
-                    nc.variables[name][offset : offset + n_write] = col[start : start + n_write]
+    # Create NetCDF files with variables, kept open while the chunks are
+    # appended
+    chunk = 5000
+    datasets = []
+    offset = 0
+    try:
+        for _, ofn, sensor_names, sensor_units in targets:
+            nc = netCDF4.Dataset(ofn, "w", format="NETCDF4")
+            datasets.append(nc)
+            nc.createDimension("i", None)
+            for name, units in zip(sensor_names, sensor_units, strict=True):
+                dtype, _ = fill_vals[name]
+                if compression > 0:
+                    v = nc.createVariable(  # type: ignore[call-overload]
+                        name,
+                        dtype,
+                        ("i",),
+                        fill_value=False,
+                        zlib=True,
+                        complevel=compression,
+                        chunksizes=(chunk,),
+                    )
                 else:
-                    _, fill = fill_vals[name]
-                    nc.variables[name][offset : offset + n_write] = np.full(n_write, fill)
-
-            offset += n_write
-            nc.setncattr("n_files", total_files)
-            nc.setncattr("total_records", offset)
-        finally:
+                    v = nc.createVariable(name, dtype, ("i",), fill_value=False)
+                v.units = units
+
+        # Pass 2: append each chunk to each NetCDF
+        for result in _prefetch(chunks, n_chunks):
+            n = int(result["n_records"])
+            col_map = dict(zip(result["sensor_names"], result["columns"], strict=True))
+            for nc, (_, _, sensor_names, _) in zip(datasets, targets, strict=True):
+                for name in sensor_names:
+                    col = col_map.get(name)
+                    if col is not None:
+                        nc.variables[name][offset : offset + n] = col[:n]
+                    else:
+                        _, fill = fill_vals[name]
+                        nc.variables[name][offset : offset + n] = np.full(n, fill)
+            offset += n
+
+            # Drop the chunk before the next is taken, so its slot is free
+            del result, col_map
+
+        if offset > 0:
+            for nc in datasets:
+                nc.setncattr("n_files", chunks.n_files)
+                nc.setncattr("total_records", offset)
+    finally:
+        for nc in datasets:
             nc.close()
 
-        # result goes out of scope — batch memory freed
-        del result, result_cols, col_map
-
-    return offset, total_files
+    for k, *_ in targets:
+        written[k] = (offset, chunks.n_files)
+    return written
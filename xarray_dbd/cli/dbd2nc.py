@@ -15,6 +15,7 @@ from pathlib import Path
 import xarray as xr
 
 import xarray_dbd as xdbd
+from xarray_dbd.backend import has_native_netcdf_writer
 from xarray_dbd.cli import logger
 
 
@@ -190,12 +191,14 @@ def run(args) -> int:
                 logging.error("Error appending to %s: %s", args.output, e)
                 return 1
         else:
-            try:
-                import netCDF4  # noqa: F401
+            has_netcdf4 = has_native_netcdf_writer()
+            if not has_netcdf4:
+                try:
+                    import netCDF4  # noqa: F401
 
-                has_netcdf4 = True
-            except ImportError:
-                has_netcdf4 = False
+                    has_netcdf4 = True
+                except ImportError:
+                    has_netcdf4 = False
 
             if has_netcdf4:
                 # Streaming mode: write directly to NetCDF without holding all data
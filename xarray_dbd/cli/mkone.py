@@ -28,54 +28,65 @@ def process_files(
     ofn: str, filenames: list[str], args: Namespace, sensors_filename: str | None = None
 ) -> None:
     """Process files using xarray-dbd"""
-    start_time = time.time()
-    logging.info("%s: %s files", ofn, len(filenames))
+    process_partitions({ofn: sensors_filename}, filenames, args)
 
-    # Make sure the directory of the output file exists
-    odir = os.path.dirname(ofn)
-    if odir and not os.path.isdir(odir):
-        logging.info("Creating %s", odir)
-        os.makedirs(odir, mode=0o755, exist_ok=True)
 
-    # Read sensor list if provided
-    to_keep = None
-    if sensors_filename:
-        with open(sensors_filename, encoding="utf-8") as f:
-            to_keep = [line.strip() for line in f if line.strip()]
+def process_partitions(
+    outputs: dict[str, str | None], filenames: list[str], args: Namespace
+) -> None:
+    """Process files into several NetCDFs, one per sensors file, in one pass"""
+    start_time = time.time()
+    names = ", ".join(outputs)
+    logging.info("%s: %s files", names, len(filenames))
+
+    to_keep: dict[str, list[str] | None] = {}
+    for ofn, sensors_filename in outputs.items():
+        # Make sure the directory of the output file exists
+        odir = os.path.dirname(ofn)
+        if odir and not os.path.isdir(odir):
+            logging.info("Creating %s", odir)
+            os.makedirs(odir, mode=0o755, exist_ok=True)
+
+        # Read sensor list if provided
+        to_keep[ofn] = None
+        if sensors_filename:
+            with open(sensors_filename, encoding="utf-8") as f:
+                to_keep[ofn] = [line.strip() for line in f if line.strip()]
 
     # Prepare arguments for xarray-dbd
     skip_missions = args.exclude if args.exclude else None
     keep_missions = args.include if args.include else None
     cache_dir = Path(args.cache) if args.cache else None
 
-    # Stream directly to NetCDF without holding all data in memory
+    # Stream directly to NetCDF without holding all data in memory, reading
+    # the files once for all the outputs
     try:
-        n_records, n_files = xdbd.write_multi_dbd_netcdf(
+        written = xdbd.write_partitioned_dbd_netcdf(
             [Path(f) for f in filenames],
-            ofn,
+            to_keep,
             skip_first_record=not args.keep_first,
             repair=args.repair,
-            to_keep=to_keep,
             skip_missions=skip_missions,
             keep_missions=keep_missions,
             cache_dir=cache_dir,
             compression=5,
         )
     except (OSError, ValueError, RuntimeError) as e:
-        logging.error("Failed to process files for %s: %s", ofn, e)
+        logging.error("Failed to process files for %s: %s", names, e)
         return
 
-    if n_records == 0:
-        logging.warning("No data for %s, skipping", ofn)
-        return
+    for ofn, (n_records, n_files) in written.items():
+        if n_records == 0:
+            logging.warning("No data for %s, skipping", ofn)
+            continue
 
-    logging.info(
-        "Wrote %s with %d records from %d files in %.2f seconds",
-        ofn,
-        n_records,
-        n_files,
-        time.time() - start_time,
-    )
+        logging.info(
+            "Wrote %s with %d records from %d files in %.2f seconds",
+            ofn,
+            n_records,
+            n_files,
+            time.time() - start_time,
+        )
 
 
 def extract_sensors(filenames: list[str], args: Namespace) -> list[str]:
@@ -124,12 +135,11 @@ def write_sensors(sensors: set[str], ofn: str) -> str:
     return ofn
 
 
-def process_dbd(filenames: list[str], args: Namespace) -> None:
-    """Process flight Dinkum Binary files"""
-    filenames = list(filenames)
-    if not filenames:
-        return  # Nothing to do
+def partition_dbd(filenames: list[str], args: Namespace) -> dict[str, str]:
+    """Write the dbd/sci/other sensor files of flight files.
 
+    Returns the output NetCDF for each partition mapped to its sensors file.
+    """
     all_sensors = set(extract_sensors(filenames, args))
     dbd_sensors = {x for x in all_sensors if x.startswith(("m_", "c_"))}
     sci_sensors = {x for x in all_sensors if x.startswith("sci_")}
@@ -142,9 +152,21 @@ def process_dbd(filenames: list[str], args: Namespace) -> None:
     sci_fn = write_sensors(sci_sensors, args.output_prefix + "dbd.sci.sensors")
     other_fn = write_sensors(other_sensors, args.output_prefix + "dbd.other.sensors")
 
-    process_all(filenames, args, "dbd.nc", dbd_fn)
-    process_all(filenames, args, "dbd.sci.nc", sci_fn)
-    process_all(filenames, args, "dbd.other.nc", other_fn)
+    return {
+        args.output_prefix + "dbd.nc": dbd_fn,
+        args.output_prefix + "dbd.sci.nc": sci_fn,
+        args.output_prefix + "dbd.other.nc": other_fn,
+    }
+
+
+def process_dbd(filenames: list[str], args: Namespace) -> None:
+    """Process flight Dinkum Binary files"""
+    filenames = sorted(filenames)
+    if not filenames:
+        return  # Nothing to do
+
+    # All three partitions from one read of the files
+    process_partitions(partition_dbd(filenames, args), filenames, args)
 
 
 def discover_files(paths: list[str]) -> dict[str, list[str]]:
@@ -231,6 +253,12 @@ def _worker(ofn, filenames, args, sensors_filename=None):
     process_files(ofn, filenames, args, sensors_filename)
 
 
+def _partition_worker(outputs, filenames, args):
+    """Multiprocessing worker — sets up logging then processes several output files."""
+    logger.mk_logger(args)
+    process_partitions(outputs, filenames, args)
+
+
 def run(args) -> int:
     """Execute the mkone batch processing."""
     logger.mk_logger(args)
@@ -257,42 +285,29 @@ def run(args) -> int:
 
     files = discover_files(args.path)
 
-    # Collect work items: (ofn, filenames, sensors_filename)
-    work: list[tuple[str, list[str], str | None]] = []
+    # Collect work items: ({ofn: sensors_filename}, filenames)
+    work: list[tuple[dict[str, str | None], list[str]]] = []
 
     if "d" in files:
         d_files = sorted(files["d"])
 
-        # Sensor extraction and partitioning (fast, sequential)
-        all_sensors = set(extract_sensors(d_files, args))
-        dbd_sensors = {x for x in all_sensors if x.startswith(("m_", "c_"))}
-        sci_sensors = {x for x in all_sensors if x.startswith("sci_")}
-        other_sensors = all_sensors.difference(dbd_sensors).difference(sci_sensors)
-        sci_sensors.add("m_present_time")
-        other_sensors.add("m_present_time")
-
-        write_sensors(all_sensors, args.output_prefix + "dbd.all.sensors")
-        dbd_fn = write_sensors(dbd_sensors, args.output_prefix + "dbd.sensors")
-        sci_fn = write_sensors(sci_sensors, args.output_prefix + "dbd.sci.sensors")
-        other_fn = write_sensors(other_sensors, args.output_prefix + "dbd.other.sensors")
-
-        work.append((args.output_prefix + "dbd.nc", d_files, dbd_fn))
-        work.append((args.output_prefix + "dbd.sci.nc", d_files, sci_fn))
-        work.append((args.output_prefix + "dbd.other.nc", d_files, other_fn))
+        # Sensor extraction and partitioning (fast, sequential); the
+        # partitions are then written by one worker reading the files once
+        work.append((dict(partition_dbd(d_files, args)), d_files))
 
     for key in ["e", "s", "t", "m", "n"]:
         if key in files:
-            work.append((args.output_prefix + key + "bd.nc", sorted(files[key]), None))
+            work.append(({args.output_prefix + key + "bd.nc": None}, sorted(files[key])))
 
     if not work:
         logging.info("No files to process")
         return 0
 
-    # Spawn one process per output file
+    # Spawn one process per work item
     processes = []
-    for ofn, flist, sensors_fn in work:
-        p = multiprocessing.Process(target=_worker, args=(ofn, flist, args, sensors_fn))
-        processes.append((p, ofn))
+    for outputs, flist in work:
+        p = multiprocessing.Process(target=_partition_worker, args=(outputs, flist, args))
+        processes.append((p, ", ".join(outputs)))
         p.start()
 
     # Wait for all to complete
@@ -10,7 +10,13 @@ import os
 
 import numpy
 
-from xarray_dbd._dbd_cpp import read_dbd_file, read_dbd_files, scan_headers, scan_sensors
+from xarray_dbd._dbd_cpp import (
+    open_dbd_file,
+    read_dbd_files,
+    scan_headers,
+    scan_sensors,
+    sync_columns,
+)
 
 from ._cache import DBDCache
 from ._errors import (
@@ -56,6 +62,40 @@ def _filter_latlon(t, v, param, discard_bad):
     return t, v
 
 
+def _sync_onto(t_ref, sources, decimal_ll, discard_bad_ll):
+    """Interpolate ``(param, t_all, v)`` sources onto *t_ref* in one native pass.
+
+    Each source is the raw time and value columns of *param* (``v`` None if
+    it was not read); the same samples are used as ``_extract`` keeps, with
+    the lat/lon filter and conversion applied. Returns one array per source.
+    """
+    result = [t_ref * numpy.nan for _ in sources]
+    found = [k for k, (_p, _t, v) in enumerate(sources) if v is not None]
+    limits = []
+    decimal = []
+    for k in found:
+        param = sources[k][0]
+        latlon = param in LATLON_PARAMS
+        limit = (9000.0 if "lat" in param else 18000.0) if latlon and discard_bad_ll else numpy.inf
+        limits.append(limit)
+        decimal.append(latlon and decimal_ll)
+    columns, counts = sync_columns(
+        t_ref,
+        [sources[k][1] for k in found],
+        [sources[k][2] for k in found],
+        limits=limits,
+        decimal=decimal,
+    )
+    n_valid = [0] * len(sources)
+    for k, col, n in zip(found, columns, counts, strict=True):
+        result[k] = col
+        n_valid[k] = n
+    for (param, _t, _v), n in zip(sources, n_valid, strict=True):
+        if not n:
+            logger.info("No valid data to interpolate for '%s'.", param)
+    return result
+
+
 class DBD:
     """Read a single DBD file with a dbdreader-compatible interface.
 
@@ -107,6 +147,7 @@ class DBD:
         self._columns: dict[str, numpy.ndarray] = {}
         self._loaded_params: set[str] = set()
         self._preload: set[str] = set(preload) if preload else set()
+        self._handle = None  # open_dbd_file handle, opened on first load
         self._closed = False
 
     # -- lazy loading ------------------------------------------------------------
@@ -120,20 +161,21 @@ class DBD:
         needed = to_load - self._loaded_params
         if not needed:
             return
-        result = read_dbd_file(
-            self.filename,
-            cache_dir=self.cacheDir or "",
-            to_keep=sorted(needed),
-            skip_first_record=self.skip_initial_line,
-        )
+        # The file is indexed once; later loads read only the new columns
+        if self._handle is None:
+            self._handle = open_dbd_file(
+                self.filename,
+                cache_dir=self.cacheDir or "",
+                skip_first_record=self.skip_initial_line,
+            )
+        result = self._handle.read(sorted(needed))
         # First load: upgrade headerInfo to the full header dict
         if not self._loaded_params:
             self.headerInfo = result["header"]
         names = result["sensor_names"]
         for i, name in enumerate(names):
-            if name:  # sparse result: non-empty name means kept column
-                self._columns[name] = numpy.asarray(result["columns"][i])
-        self._loaded_params |= {n for n in names if n}
+            self._columns[name] = numpy.asarray(result["columns"][i])
+        self._loaded_params |= set(names)
 
     # -- public methods ----------------------------------------------------------
 
@@ -156,6 +198,7 @@ class DBD:
         self._closed = True
         self._columns = {}
         self._loaded_params = set()
+        self._handle = None
         self.parameterNames = []
         self.parameterUnits = {}
 
@@ -329,24 +372,15 @@ class DBD:
         if self._closed:
             raise DbdError(DBD_ERROR_NO_TIME_VARIABLE, "DBD object is closed")
         self._ensure_loaded(params)
-        t_all = self._columns[self.timeVariable].astype(numpy.float64)
-        tv_pairs = [
-            self._extract_param(t_all, p, False, decimalLatLon, discardBadLatLon) for p in params
-        ]
-
-        t_ref = tv_pairs[0][0]
+        t_raw = self._columns[self.timeVariable]
+        t_ref, v_ref = self._extract_param(
+            t_raw.astype(numpy.float64), params[0], False, decimalLatLon, discardBadLatLon
+        )
         if t_ref.shape[0] == 0:
             raise DbdError(DBD_ERROR_NO_DATA_TO_INTERPOLATE_TO)
 
-        r = [t_ref, tv_pairs[0][1]]
-        for i, (_t, _v) in enumerate(tv_pairs[1:], 1):
-            try:
-                r.append(numpy.interp(t_ref, _t, _v, left=numpy.nan, right=numpy.nan))
-            except ValueError:
-                r.append(t_ref * numpy.nan)
-                logger.info("No valid data to interpolate for '%s'.", params[i])
-
-        return tuple(r)
+        sources = [(p, t_raw, self._columns.get(p)) for p in params[1:]]
+        return (t_ref, v_ref, *_sync_onto(t_ref, sources, decimalLatLon, discardBadLatLon))
 
 
 class MultiDBD:
@@ -507,17 +541,7 @@ class MultiDBD:
                 "potentially yields undefined behaviour.\n"
             )
 
-        # Validate parameters
-        all_known = set(self.parameterNames.get("eng", [])) | set(
-            self.parameterNames.get("sci", [])
-        )
-        invalid = [p for p in parameters if p not in all_known]
-        if invalid:
-            if len(invalid) == 1:
-                mesg = f"Parameter {invalid[0]} is an unknown glider sensor name."
-            else:
-                mesg = f"Parameters {{{','.join(invalid)}}} are unknown glider sensor names."
-            raise DbdError(value=DBD_ERROR_NO_VALID_PARAMETERS, mesg=mesg, data=invalid)
+        self._check_parameters(parameters)
 
         if include_source:
             return self._get_with_source(
@@ -558,39 +582,33 @@ class MultiDBD:
         if len(parameters) == 2 and isinstance(parameters[1], (list, tuple)):
             parameters = (parameters[0], *parameters[1])
 
-        tv = self.get(
-            *parameters,
-            decimalLatLon=decimalLatLon,
-            discardBadLatLon=discardBadLatLon,
-            return_nans=False,
-        )
-        # Normalise to list of tuples
-        if len(parameters) == 1:
-            tv = [tv]
-
-        t = tv[0][0]
-        r = []
-        for i, (p, (_t, _v)) in enumerate(zip(parameters, tv, strict=True)):
-            if i == 0:
-                r.append(_t)
-                r.append(_v)
+        self._check_parameters(parameters)
+        self._ensure_loaded(parameters)
+        t, v = self._extract(parameters[0], False, decimalLatLon, discardBadLatLon)
+
+        # Parameters without an interpolating function are synced natively,
+        # straight from their columns, in one pass
+        r = [t, v]
+        native = []
+        for p in parameters[1:]:
+            ifun_factory = self._resolve_ifun(p, interpolating_function_factory)
+            if ifun_factory is None:
+                raw = self._raw_columns(p)
+                native.append((len(r), (p, *raw) if raw else (p, None, None)))
+                r.append(None)
+                continue
+            _t, _v = self._extract(p, False, decimalLatLon, discardBadLatLon)
+            try:
+                ifun = ifun_factory(_t, _v)
+            except ValueError:
+                r.append(t * numpy.nan)
+                logger.info("No valid data to interpolate for '%s'.", p)
             else:
-                ifun_factory = self._resolve_ifun(p, interpolating_function_factory)
-                if ifun_factory is None:
-                    # Use numpy.interp directly
-                    try:
-                        r.append(numpy.interp(t, _t, _v, left=numpy.nan, right=numpy.nan))
-                    except ValueError:
-                        r.append(t * numpy.nan)
-                        logger.info("No valid data to interpolate for '%s'.", p)
-                else:
-                    try:
-                        ifun = ifun_factory(_t, _v)
-                    except ValueError:
-                        r.append(t * numpy.nan)
-                        logger.info("No valid data to interpolate for '%s'.", p)
-                    else:
-                        r.append(ifun(t))
+                r.append(ifun(t))
+
+        synced = _sync_onto(t, [src for _, src in native], decimalLatLon, discardBadLatLon)
+        for (i, _), col in zip(native, synced, strict=True):
+            r[i] = col
 
         return tuple(r)
 
@@ -816,6 +834,32 @@ class MultiDBD:
                 self._sci_columns[name] = numpy.asarray(result["columns"][i])
             self._loaded_sci_params |= set(names)
 
+    def _check_parameters(self, parameters):
+        """Raise DbdError for names in *parameters* that are not known sensors."""
+        all_known = set(self.parameterNames.get("eng", [])) | set(
+            self.parameterNames.get("sci", [])
+        )
+        invalid = [p for p in parameters if p not in all_known]
+        if invalid:
+            if len(invalid) == 1:
+                mesg = f"Parameter {invalid[0]} is an unknown glider sensor name."
+            else:
+                mesg = f"Parameters {{{','.join(invalid)}}} are unknown glider sensor names."
+            raise DbdError(value=DBD_ERROR_NO_VALID_PARAMETERS, mesg=mesg, data=invalid)
+
+    def _raw_columns(self, param):
+        """Return the raw ``(time, values)`` columns of a loaded *param*, or None."""
+        if param in self._sci_columns:
+            columns = self._sci_columns
+        elif param in self._eng_columns:
+            columns = self._eng_columns
+        else:
+            return None
+        tv_name = self._find_time_var(columns)
+        if tv_name is None:
+            raise DbdError(DBD_ERROR_NO_TIME_VARIABLE)
+        return columns[tv_name], columns[param]
+
     def _find_time_var(self, columns):
         """Return the time variable name present in *columns*."""
         for tv in ("m_present_time", "sci_m_present_time"):